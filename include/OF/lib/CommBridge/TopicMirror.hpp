@@ -0,0 +1,177 @@
+// Copyright (c) 2025. MoonFeather
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OF_LIB_COMMBRIDGE_TOPICMIRROR_HPP
+#define OF_LIB_COMMBRIDGE_TOPICMIRROR_HPP
+
+#include <OF/lib/CommBridge/CommBridge.hpp>
+#include <OF/lib/Node/NodeManager.hpp>
+
+#include <cstring>
+#include <span>
+
+#include <zephyr/sys/util.h>
+
+#ifndef CONFIG_COMM_BRIDGE_TOPIC_MIRROR
+#error "TopicMirror requires CONFIG_COMM_BRIDGE_TOPIC_MIRROR"
+#endif
+
+/**
+ * @brief Topic 镜像的通用数据包
+ *
+ * 一个样本按 CONFIG_COMM_BRIDGE_TOPIC_MIRROR_CHUNK 字节分片发送，上位机按 (topic, seq) 以 offset 拼接，
+ * 收齐 total 字节即得到完整样本。seq 为 0 的包是 Topic 声明，payload 中为 Topic 名称，
+ * 用于建立 topic 下标与名称的对应关系。
+ */
+struct TopicMirrorPacket
+{
+    uint16_t topic; // Topic 在 OF::all_topics() 中的下标
+    uint16_t offset; // 本片在样本中的字节偏移
+    uint32_t seq; // 样本的发布序号
+    uint16_t total; // 样本总字节数
+    uint8_t len; // 本片有效字节数
+    uint8_t reserved;
+    uint8_t payload[CONFIG_COMM_BRIDGE_TOPIC_MIRROR_CHUNK];
+};
+
+template <>
+struct RPL::Meta::PacketTraits<TopicMirrorPacket> : PacketTraitsBase<PacketTraits<TopicMirrorPacket>>
+{
+    static constexpr uint16_t cmd = 0xF0FE;
+    static constexpr size_t size = sizeof(TopicMirrorPacket);
+};
+
+namespace OF
+{
+    // 需要镜像的 Topic 及其发送频率上限，max_hz 为 0 表示每次有新样本都发送
+    struct MirrorEntry
+    {
+        const char* name;
+        uint32_t max_hz;
+    };
+
+    /**
+     * @brief 把选定 Topic 的新样本通过 CommBridge 转发到上位机
+     *
+     * 由调用者所在的线程周期性调用 poll()：序号未变化的 Topic 只读取一次元信息，不占用串口带宽；
+     * 有新样本且距离上次发送已超过频率上限对应的周期时，读取最新样本并分片发送。
+     * Bridge 的发送包列表中必须包含 TopicMirrorPacket。
+     */
+    template <typename Bridge, size_t MaxTopics = CONFIG_COMM_BRIDGE_TOPIC_MIRROR_MAX_TOPICS>
+    class TopicMirror
+    {
+    public:
+        TopicMirror(Bridge& bridge, const std::span<const MirrorEntry> entries) :
+            m_bridge(bridge)
+        {
+            LOG_MODULE_DECLARE(CommBridge, CONFIG_COMM_BRIDGE_LOG_LEVEL);
+
+            for (const auto& entry : entries)
+            {
+                const topic_desc* desc = find_topic(entry.name);
+                if (desc == nullptr || desc->read_func == nullptr)
+                {
+                    LOG_ERR("Mirror: topic '%s' not found", entry.name);
+                    continue;
+                }
+                if (desc->type_size > sizeof(m_sample))
+                {
+                    LOG_ERR("Mirror: topic '%s' (%u bytes) exceeds CONFIG_COMM_BRIDGE_TOPIC_MIRROR_MAX_SAMPLE",
+                            entry.name, desc->type_size);
+                    continue;
+                }
+                if (m_cnt == MaxTopics)
+                {
+                    LOG_ERR("Mirror: more than %u topics, '%s' ignored", static_cast<uint32_t>(MaxTopics),
+                            entry.name);
+                    continue;
+                }
+                m_states[m_cnt++] = State{
+                    .desc = desc,
+                    .min_period = entry.max_hz == 0 ? 0 : k_ms_to_ticks_ceil64(1000) / entry.max_hz,
+                };
+            }
+        }
+
+        TopicMirror(const TopicMirror&) = delete;
+        TopicMirror& operator=(const TopicMirror&) = delete;
+
+        // 检查所有 Topic 并发送有变化的样本，返回本次发送的样本数
+        size_t poll()
+        {
+            const int64_t now = k_uptime_ticks();
+            if (now >= m_next_announce)
+            {
+                announce();
+                m_next_announce = now + k_ms_to_ticks_ceil64(CONFIG_COMM_BRIDGE_TOPIC_MIRROR_ANNOUNCE_MS);
+            }
+
+            size_t sent = 0;
+            for (size_t i = 0; i < m_cnt; ++i)
+            {
+                auto& state = m_states[i];
+                if (now < state.next_due || state.desc->meta_func(state.desc).seq == state.last_seq)
+                {
+                    continue;
+                }
+                const uint32_t seq = state.desc->read_func(state.desc, m_sample);
+                if (seq == 0 || seq == state.last_seq)
+                {
+                    continue;
+                }
+                send(state.desc, seq, m_sample, state.desc->type_size);
+                state.last_seq = seq;
+                state.next_due = now + state.min_period;
+                ++sent;
+            }
+            return sent;
+        }
+
+        // 立即重发所有 Topic 的声明包，例如上位机重新连接之后
+        void announce()
+        {
+            for (size_t i = 0; i < m_cnt; ++i)
+            {
+                const topic_desc* desc = m_states[i].desc;
+                send(desc, 0, desc->name, strlen(desc->name));
+            }
+        }
+
+    private:
+        struct State
+        {
+            const topic_desc* desc{nullptr};
+            int64_t min_period{0}; // 相邻两次发送的最小间隔（tick）
+            int64_t next_due{0};
+            uint32_t last_seq{0};
+        };
+
+        void send(const topic_desc* desc, const uint32_t seq, const void* data, const size_t size)
+        {
+            m_packet.topic = static_cast<uint16_t>(desc - all_topics().data());
+            m_packet.seq = seq;
+            m_packet.total = static_cast<uint16_t>(size);
+
+            size_t offset = 0;
+            do
+            {
+                const size_t len = MIN(size - offset, sizeof(m_packet.payload));
+                m_packet.offset = static_cast<uint16_t>(offset);
+                m_packet.len = static_cast<uint8_t>(len);
+                std::memcpy(m_packet.payload, static_cast<const uint8_t*>(data) + offset, len);
+                m_bridge.send(m_packet);
+                offset += len;
+            }
+            while (offset < size);
+        }
+
+        Bridge& m_bridge;
+        State m_states[MaxTopics]{};
+        size_t m_cnt{0};
+        int64_t m_next_announce{0};
+        TopicMirrorPacket m_packet{};
+        alignas(max_align_t) uint8_t m_sample[CONFIG_COMM_BRIDGE_TOPIC_MIRROR_MAX_SAMPLE]{};
+    };
+}
+
+#endif //OF_LIB_COMMBRIDGE_TOPICMIRROR_HPP
@@ -1,6 +1,9 @@
 #ifndef OF_LIB_IMU_HUB_HPP
 #define OF_LIB_IMU_HUB_HPP
 
+#include <cmath>
+#include <optional>
+
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 
@@ -26,6 +29,37 @@ namespace OF
         struct Quaternion
         {
             float w, x, y, z; /**< Unit quaternion components (w is scalar part). */
+
+            /**
+             * @brief Spherical linear interpolation towards @p to, used by HistoryBuf::sample_at().
+             *
+             * Takes the shorter arc and falls back to normalized lerp when the two
+             * orientations are nearly identical.
+             */
+            [[nodiscard]] Quaternion interpolate(const Quaternion& to, const float alpha) const
+            {
+                float dot = w * to.w + x * to.x + y * to.y + z * to.z;
+                const float sign = dot < 0.0f ? -1.0f : 1.0f;
+                dot *= sign;
+
+                float k0 = 1.0f - alpha;
+                float k1 = alpha * sign;
+                if (dot < 0.9995f)
+                {
+                    const float theta = std::acos(dot);
+                    const float inv_sin = 1.0f / std::sin(theta);
+                    k0 = std::sin(k0 * theta) * inv_sin;
+                    k1 = std::sin(alpha * theta) * inv_sin * sign;
+                }
+
+                Quaternion q{k0 * w + k1 * to.w, k0 * x + k1 * to.x, k0 * y + k1 * to.y, k0 * z + k1 * to.z};
+                const float norm = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+                if (norm > 1e-6f)
+                {
+                    q = {q.w / norm, q.x / norm, q.y / norm, q.z / norm};
+                }
+                return q;
+            }
         } quat;
 
         struct EulerAngle
@@ -80,6 +114,19 @@ namespace OF
 
         static IMUData getData();
 
+#if !defined(CONFIG_IMU_HUB_RESOLVER_NONE) && CONFIG_IMU_HUB_HISTORY_N > 0
+        /**
+         * @brief Attitude at a past moment, slerped between the two nearest published samples.
+         *
+         * Intended for latency compensation, e.g. the gimbal attitude at the time a camera
+         * frame was exposed. Only the last CONFIG_IMU_HUB_HISTORY_N published samples are kept.
+         *
+         * @param stamp Moment to look up, in k_cycle_get_32() cycles (same base as Sample::stamp).
+         * @return The interpolated attitude, or std::nullopt if @p stamp is older than the history.
+         */
+        static std::optional<IMUData::Quaternion> getAttitudeAt(uint32_t stamp);
+#endif
+
     private:
         /**
          * @brief RTIO completion callback invoked for each async sensor read.
@@ -0,0 +1,129 @@
+#ifndef OF_LIB_NODE_CALLBACK_HPP
+#define OF_LIB_NODE_CALLBACK_HPP
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+#include "Descriptor.hpp"
+
+namespace OF
+{
+    /*
+     * Topic 回调订阅
+     *
+     * 回调由 ONE_TOPIC_CALLBACK 静态注册到 topic_callback 段，启动时挂到对应 Topic 的链表上。
+     * 写者提交槽位后在自己的上下文中依次调用：
+     *   Inline   直接调用回调，延迟最低；写者可能是 ISR，回调必须短小且不能阻塞
+     *   Deferred 只向专用工作队列提交 k_work，回调在工作队列线程中读取最新样本后执行；
+     *            工作项未执行前的多次发布会合并为一次
+     */
+    enum class CallbackMode : uint8_t
+    {
+        Inline,
+        Deferred,
+    };
+
+    struct topic_callback;
+
+    // 写者上下文中 data 指向刚提交的样本；工作队列中 data 为 nullptr
+    typedef void (*topic_callback_invoke_t)(topic_callback* cb, const void* data);
+
+    struct topic_callback
+    {
+        topic_link link; // 订阅的 Topic，类型检查同 ONE_NODE_SUBSCRIBES
+        const char* name;
+        CallbackMode mode;
+        topic_callback_invoke_t invoke;
+
+        // 以下由 attach_topic_callbacks() 在启动时填写
+        topic_callback* next;
+        k_work work;
+    };
+
+    // 把 topic_callback 段中的回调挂到对应 Topic 上，由 Node.cpp 在检查 Topic 表之后调用
+    void attach_topic_callbacks();
+
+    // 把 Deferred 回调提交到回调工作队列
+    void submit_topic_callback(topic_callback* cb);
+
+    // 支持回调的 Topic 类型，LoanedTopic 等不支持
+    template <typename TopicT>
+    concept CallbackTopic = requires(const topic_desc* desc, topic_callback* cb)
+    {
+        TopicT::attach_stub(desc, cb);
+    };
+
+    template <typename T, void (*Func)(const T&), CallbackMode Mode>
+    void topic_callback_stub(topic_callback* cb, const void* data)
+    {
+        if constexpr (Mode == CallbackMode::Inline)
+        {
+            Func(*static_cast<const T*>(data));
+        }
+        else if (data != nullptr)
+        {
+            submit_topic_callback(cb);
+        }
+        else
+        {
+            T val{};
+            cb->link.desc->read_func(cb->link.desc, &val);
+            Func(val);
+        }
+    }
+
+#ifdef CONFIG_TOPIC_CALLBACKS
+    // Topic 中的回调链表头，没有订阅者时写路径只多一次指针判空
+    class CallbackList
+    {
+    public:
+        void attach(topic_callback* cb)
+        {
+            topic_callback** tail = &m_head;
+            while (*tail != nullptr)
+            {
+                tail = &(*tail)->next;
+            }
+            cb->next = nullptr;
+            *tail = cb;
+        }
+
+        void dispatch(const void* data) const
+        {
+            for (topic_callback* cb = m_head; cb != nullptr; cb = cb->next)
+            {
+                cb->invoke(cb, data);
+            }
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return m_head == nullptr;
+        }
+
+    private:
+        topic_callback* m_head{nullptr};
+    };
+#else
+    // 关闭时为空类型，配合 [[no_unique_address]] 不占空间
+    class CallbackList
+    {
+    public:
+        void attach(topic_callback*)
+        {
+        }
+
+        void dispatch(const void*) const
+        {
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return true;
+        }
+    };
+#endif
+}
+
+#endif //OF_LIB_NODE_CALLBACK_HPP
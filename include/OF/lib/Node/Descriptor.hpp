@@ -1,19 +1,100 @@
 #ifndef OF_LIB_NODE_DESCRIPTOR_HPP
 #define OF_LIB_NODE_DESCRIPTOR_HPP
+#include <string_view>
+
 #include <zephyr/kernel.h>
 
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/FormatSink.hpp>
+
 namespace OF
 {
+    struct topic_desc;
+
+    // Node 与 Topic 之间的一条连接，由 ONE_NODE_PUBLISHES / ONE_NODE_SUBSCRIBES 生成。
+    // type_check 指向注册 Topic 时按实际类型特化的空函数，声明的类型不一致时链接失败。
+    struct topic_link
+    {
+        const topic_desc* desc;
+        void (*type_check)();
+    };
+
     struct node_desc
     {
         const char* name;
         k_tid_t* thread_id_ptr;
 
         void (*start_func)();
+
+        // Meta 中声明的发布与订阅，供 topic_graph.py 在构建后生成 Topic 图
+        const topic_link* publishes;
+        const topic_link* subscribes;
+        uint8_t publish_cnt;
+        uint8_t subscribe_cnt;
+    };
+
+    // Node 之外的发布者（ISR、驱动等），由 ONE_TOPIC_PUBLISHER 注册
+    struct topic_publisher
+    {
+        const char* name;
+        topic_link link;
     };
 
-    typedef void (*print_func_t)(const struct topic_desc* desc);
+    // 上述描述符的成员偏移与大小，由 Node.cpp 按实际定义填写并放入不占内存的 .topic_layout 信息段（见 linker/node_info.ld），
+    // topic_graph.py 据此解析 ELF，结构体改动后无需同步修改脚本；成员只能追加，脚本按顺序读取
+    struct topic_layout
+    {
+        uint32_t desc_size;
+        uint32_t desc_name;
+        uint32_t desc_type_size;
+        uint32_t desc_footprint;
+        uint32_t node_size;
+        uint32_t node_name;
+        uint32_t node_publishes;
+        uint32_t node_subscribes;
+        uint32_t node_publish_cnt;
+        uint32_t node_subscribe_cnt;
+        uint32_t link_size;
+        uint32_t link_desc;
+        uint32_t publisher_size;
+        uint32_t publisher_name;
+        uint32_t publisher_link;
+    };
+
+    // 最新一次发布的序号与 k_cycle_get_32() 时间戳，seq 为 0 表示从未发布
+    struct topic_meta
+    {
+        uint32_t seq;
+        uint32_t stamp;
+    };
+
+    // 按 TopicOptions::deadline_ms / liveliness_ms 判断的最新样本状态
+    enum class TopicStatus : uint8_t
+    {
+        Fresh, // 在发布期限内，或未声明 QoS
+        Stale, // 距上次发布超过 deadline_ms
+        Expired, // 距上次发布超过 liveliness_ms，写者可能已失效
+        NoData, // 从未发布
+    };
+
+    struct topic_callback;
+
+    // 把最新样本格式化到 sink（不含换行），返回该样本的发布序号，从未发布时返回 0
+    typedef uint32_t (*format_func_t)(const struct topic_desc* desc, FormatSink& sink);
     typedef size_t (*get_size_func_t)();
+    typedef topic_meta (*meta_func_t)(const struct topic_desc* desc);
+    // 读取竞争统计，reset 为 true 时读取后清零；CONFIG_TOPIC_STATS 关闭时返回全 0
+    typedef BufStatsSnapshot (*stats_func_t)(const struct topic_desc* desc, bool reset);
+    // 以类型擦除的方式发布一个样本，data 指向 type_size 字节的数据（不要求对齐）
+    typedef void (*write_func_t)(const struct topic_desc* desc, const void* data);
+    // 把最新样本按字节拷贝到 out（type_size 字节，不要求对齐），返回其发布序号
+    typedef uint32_t (*read_func_t)(const struct topic_desc* desc, void* out);
+    // 选择或取消录制该 Topic 的发布
+    typedef void (*record_func_t)(const struct topic_desc* desc, bool enable);
+    // 最新样本的 QoS 状态，只比较一次时间戳；age_ms 非空时同时写入按 QoS 时钟（系统 tick）计算的样本年龄
+    typedef TopicStatus (*status_func_t)(const struct topic_desc* desc, uint32_t* age_ms);
+    // 把回调挂到该 Topic 的回调链表上，只在启动时调用
+    typedef void (*attach_func_t)(const struct topic_desc* desc, topic_callback* cb);
 
     struct topic_desc
     {
@@ -21,8 +102,39 @@ namespace OF
         void* topic_instance;
 
         uint32_t type_size;
-        print_func_t print_func;
+        uint32_t footprint; // Topic 实例占用的内存字节数，含全部缓冲槽位
+        format_func_t format_func;
+        meta_func_t meta_func;
+        stats_func_t stats_func;
+        write_func_t write_func;
+        read_func_t read_func;
+        record_func_t record_func;
+        status_func_t status_func; // 未声明 QoS 时为 nullptr
+        attach_func_t attach_func;
+        uint32_t deadline_ms;
+        uint32_t liveliness_ms;
+        bool multi_writer;
     };
+
+    // Topic 名称会成为 topic_desc 的输入段名，链接器按段名排序后即可二分查找，
+    // 因此只允许字母、数字、'_' 和 '.'。
+    consteval bool is_valid_topic_name(const std::string_view name)
+    {
+        if (name.empty())
+        {
+            return false;
+        }
+        for (const char c : name)
+        {
+            const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                c == '_' || c == '.';
+            if (!valid)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 #endif //OF_LIB_NODE_DESCRIPTOR_HPP
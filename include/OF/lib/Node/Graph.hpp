@@ -0,0 +1,123 @@
+#ifndef OF_LIB_NODE_GRAPH_HPP
+#define OF_LIB_NODE_GRAPH_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/NBuf.hpp>
+
+#include "Descriptor.hpp"
+
+#ifdef CONFIG_TOPIC_GRAPH_PRUNE
+// 由 scripts/topic_graph.py 在 CMake 配置时生成，为每个被裁剪的 Topic 变量定义 OF_TOPIC_PRUNED_<变量名>
+#include <generated/topic_graph.h>
+#endif
+
+namespace OF
+{
+    // Meta 中未使用 ONE_NODE_PUBLISHES / ONE_NODE_SUBSCRIBES 时为空
+    template <typename Meta>
+    consteval std::span<const topic_link> node_publishes()
+    {
+        if constexpr (requires { Meta::publishes; })
+        {
+            static_assert(std::size(Meta::publishes) <= UINT8_MAX, "too many published topics");
+            return Meta::publishes;
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    template <typename Meta>
+    consteval std::span<const topic_link> node_subscribes()
+    {
+        if constexpr (requires { Meta::subscribes; })
+        {
+            static_assert(std::size(Meta::subscribes) <= UINT8_MAX, "too many subscribed topics");
+            return Meta::subscribes;
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    template <typename...>
+    inline constexpr bool pruned_topic_read = false;
+
+    /**
+     * @brief 被 CONFIG_TOPIC_GRAPH_PRUNE 裁剪的 Topic 使用的缓冲区，不含任何槽位
+     *
+     * 写入直接丢弃，世代号恒为 0；读取接口只在被调用时实例化并编译失败，
+     * 因此漏写 ONE_NODE_SUBSCRIBES 的读者不会悄悄读到默认值。
+     */
+    template <typename T>
+    class PrunedBuf
+    {
+    public:
+        using value_type = T;
+
+        uint32_t write(const T&) noexcept
+        {
+            return 0;
+        }
+
+        template <typename Func>
+        uint32_t manipulate(const Func& func)
+        {
+            T scratch{};
+            func(scratch);
+            return 0;
+        }
+
+        template <typename Func>
+        uint32_t update(const Func& func)
+        {
+            return manipulate(func);
+        }
+
+        [[nodiscard]] uint32_t generation() const noexcept
+        {
+            return 0;
+        }
+
+        [[nodiscard]] SampleMeta read_meta() const noexcept
+        {
+            return {};
+        }
+
+        [[nodiscard]] BufStatsSnapshot stats() const noexcept
+        {
+            return {};
+        }
+
+        void reset_stats() noexcept
+        {
+        }
+
+#define OF_PRUNED_TOPIC_READ(Method, Ret) \
+        template <typename... Args> \
+        Ret Method(Args&&...) const \
+        { \
+            static_assert(pruned_topic_read<Args..., T>, \
+                "topic was pruned because no node subscribes to it, declare the reader with ONE_NODE_SUBSCRIBES"); \
+            return {}; \
+        }
+
+        OF_PRUNED_TOPIC_READ(try_read, std::optional<T>)
+        OF_PRUNED_TOPIC_READ(read, T)
+        OF_PRUNED_TOPIC_READ(read_with_meta, Sample<T>)
+        OF_PRUNED_TOPIC_READ(read_into, uint32_t)
+        OF_PRUNED_TOPIC_READ(read_into_wait_free, uint32_t)
+        OF_PRUNED_TOPIC_READ(read_at, bool)
+        OF_PRUNED_TOPIC_READ(visit, int)
+
+#undef OF_PRUNED_TOPIC_READ
+    };
+}
+
+#endif //OF_LIB_NODE_GRAPH_HPP
@@ -0,0 +1,283 @@
+#ifndef OF_LIB_NODE_LOANEDTOPIC_HPP
+#define OF_LIB_NODE_LOANEDTOPIC_HPP
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <OF/utils/BlockPool.hpp>
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/Notifier.hpp>
+#include <OF/utils/SmpFence.hpp>
+#include <OF/lib/Node/Descriptor.hpp>
+
+#include "Topic.hpp"
+#include "WaitAny.hpp"
+
+namespace OF
+{
+    /**
+     * @brief 借出式 Topic，适用于裁判系统 UI 帧、视觉目标列表、日志块等大块或变长数据
+     *
+     * 数据放在 Count 个静态块组成的池中，写者 loan() 一个块、原地填写后 publish() 其句柄；
+     * 读者 acquire() 得到最新块的只读共享句柄，句柄全部释放后块回到池中。
+     * 写者与读者之间、读者与读者之间都不拷贝数据，读写路径只有引用计数的原子操作。
+     *
+     * 池中至少有一个块被 Topic 自身持有作为最新样本，写者正在填写的块与读者持有的句柄也各占一个块，
+     * Count 应不小于 2 + 同时持有的读者句柄数，否则 loan() 会失败。
+     * 不支持录制与回调；topic echo、TopicMirror 与回放通过 read_func / write_func 按字节拷贝整个 T。
+     */
+    template <typename T, size_t Count = CONFIG_TOPIC_LOAN_POOL_N>
+    class LoanedTopic
+    {
+    public:
+        using value_type = T;
+        using Pool = BlockPool<T, Count>;
+
+        // 借出一个块，池耗尽时返回空的 Loan
+        Loan<T> loan()
+        {
+            return m_pool.loan();
+        }
+
+        /**
+         * @brief 发布写者填写好的块，之后 loan 变为空
+         *
+         * 可在 ISR 中调用；多个写者并发发布时最新样本为序号最大的块，晚于更新样本完成发布的旧块直接回到池中。
+         * @return 本次发布的序号，loan 为空时返回 0
+         */
+        uint32_t publish(Loan<T>&& loan)
+        {
+            auto* block = loan.detach();
+            if (block == nullptr)
+            {
+                return 0;
+            }
+
+            m_stats.on_write();
+            const auto seq = static_cast<uint32_t>(atomic_inc(&m_claim_seq)) + 1;
+            block->seq = seq;
+            block->stamp = k_cycle_get_32();
+            smp_write_fence();
+
+            // 写者的引用转交给 Topic，被替换的旧块释放 Topic 持有的引用。
+            // 与 NBuf::commit_multi 相同，序号与块号在同一个原子字中比较和替换，只有更新的发布才能成为最新块
+            const auto packed = pack_latest(seq, m_pool.index_of(block));
+            while (true)
+            {
+                const auto cur = atomic_get(&m_latest);
+                if (cur != 0 && !is_newer(packed, cur))
+                {
+                    block->release();
+                    break;
+                }
+                if (atomic_cas(&m_latest, cur, packed))
+                {
+                    if (cur != 0)
+                    {
+                        m_pool.block(latest_idx(cur)).release();
+                    }
+                    break;
+                }
+            }
+
+            // 最新块替换之后再推进世代号，wait_next() 返回时 acquire() 一定能取得该次发布
+            while (true)
+            {
+                const auto gen = atomic_get(&m_generation);
+                if (static_cast<int32_t>(seq - static_cast<uint32_t>(gen)) <= 0 || atomic_cas(&m_generation, gen, seq))
+                {
+                    break;
+                }
+            }
+            m_notifier.notify();
+            return seq;
+        }
+
+        /**
+         * @brief 取得最新块的只读共享句柄
+         *
+         * 取得引用后再确认该块仍是最新块，避免拿到刚被替换并已重新借出的块；失败时重试。
+         * 从未发布时返回空句柄。
+         */
+        Shared<T> acquire() const
+        {
+            const uint32_t start = BufStats::now();
+            uint32_t retries{};
+            while (true)
+            {
+                const auto latest = atomic_get(&m_latest);
+                if (latest == 0)
+                {
+                    return {};
+                }
+
+                auto& block = m_pool.block(latest_idx(latest));
+                if (block.try_retain())
+                {
+                    if (atomic_get(&m_latest) == latest)
+                    {
+                        smp_read_fence();
+                        m_stats.on_read(retries, 0, start);
+                        return Shared<T>(&block);
+                    }
+                    block.release();
+                }
+                ++retries;
+            }
+        }
+
+        [[nodiscard]] uint32_t generation() const
+        {
+            return static_cast<uint32_t>(atomic_get(&m_generation));
+        }
+
+        /**
+         * @brief 阻塞等待世代号离开 seen，见 Topic::wait_next
+         */
+        bool wait_next(uint32_t& seen, k_timeout_t timeout)
+        {
+            m_notifier.wait_while([this, seen] { return generation() == seen; }, timeout);
+
+            const uint32_t gen = generation();
+            if (gen == seen)
+            {
+                return false;
+            }
+            seen = gen;
+            return true;
+        }
+
+        Notifier& notifier()
+        {
+            return m_notifier;
+        }
+
+        // 当前空闲的块数与借出失败次数，用于评估 Count 是否足够
+        [[nodiscard]] size_t available() const
+        {
+            return m_pool.available();
+        }
+
+        [[nodiscard]] uint32_t loan_failures() const
+        {
+            return m_pool.failures();
+        }
+
+        static void print_stub(const topic_desc* desc)
+        {
+            print_topic_latest<LoanedTopic>(desc);
+        }
+
+        static uint32_t format_stub(const topic_desc* desc, FormatSink& sink)
+        {
+            const auto* self = static_cast<const LoanedTopic*>(desc->topic_instance);
+            if (const Shared<T> val = self->acquire())
+            {
+                format_topic_value(sink, *val);
+                return val.seq();
+            }
+            return 0;
+        }
+
+        static topic_meta meta_stub(const topic_desc* desc)
+        {
+            const auto* self = static_cast<const LoanedTopic*>(desc->topic_instance);
+            if (const Shared<T> val = self->acquire())
+            {
+                return {val.seq(), val.stamp()};
+            }
+            return {};
+        }
+
+        static void write_stub(const topic_desc* desc, const void* data)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                auto* self = static_cast<LoanedTopic*>(desc->topic_instance);
+                if (Loan<T> loan = self->loan())
+                {
+                    std::memcpy(loan.get(), data, sizeof(T));
+                    self->publish(std::move(loan));
+                }
+            }
+        }
+
+        static uint32_t read_stub(const topic_desc* desc, void* out)
+        {
+            const auto* self = static_cast<const LoanedTopic*>(desc->topic_instance);
+            if (const Shared<T> val = self->acquire())
+            {
+                std::memcpy(out, val.get(), sizeof(T));
+                return val.seq();
+            }
+            return 0;
+        }
+
+        static BufStatsSnapshot stats_stub(const topic_desc* desc, const bool reset)
+        {
+            auto* self = static_cast<LoanedTopic*>(desc->topic_instance);
+            const BufStatsSnapshot stats = self->m_stats.snapshot();
+            if (reset)
+            {
+                self->m_stats.reset();
+            }
+            return stats;
+        }
+
+    private:
+        // m_latest 低 IDX_BITS 位为最新块的下标 + 1，其余位为其发布序号的低位，0 表示从未发布
+        static constexpr unsigned IDX_BITS = std::bit_width(Count);
+        static constexpr uint32_t IDX_MASK = (1U << IDX_BITS) - 1;
+
+        static constexpr atomic_val_t pack_latest(const uint32_t seq, const size_t idx)
+        {
+            return static_cast<atomic_val_t>((seq << IDX_BITS) | static_cast<uint32_t>(idx + 1));
+        }
+
+        static size_t latest_idx(const atomic_val_t latest)
+        {
+            return (static_cast<uint32_t>(latest) & IDX_MASK) - 1;
+        }
+
+        // 按回绕差值比较两个 m_latest 中的序号位
+        static bool is_newer(const atomic_val_t a, const atomic_val_t b)
+        {
+            return static_cast<int32_t>((static_cast<uint32_t>(a) & ~IDX_MASK) - (static_cast<uint32_t>(b) & ~IDX_MASK)) > 0;
+        }
+
+        mutable Pool m_pool;
+        atomic_t m_latest = ATOMIC_INIT(0);
+        atomic_t m_generation = ATOMIC_INIT(0);
+        atomic_t m_claim_seq = ATOMIC_INIT(0);
+        Notifier m_notifier;
+        [[no_unique_address]] mutable BufStats m_stats;
+    };
+
+    namespace detail
+    {
+        template <typename T, size_t Count>
+        struct WaitSource<LoanedTopic<T, Count>>
+        {
+            static uint32_t baseline(const LoanedTopic<T, Count>& topic)
+            {
+                return topic.generation();
+            }
+
+            static bool has_new(const LoanedTopic<T, Count>& topic, const uint32_t baseline)
+            {
+                return topic.generation() != baseline;
+            }
+
+            static Notifier& notifier(LoanedTopic<T, Count>& topic)
+            {
+                return topic.notifier();
+            }
+        };
+    }
+}
+
+#endif //OF_LIB_NODE_LOANEDTOPIC_HPP
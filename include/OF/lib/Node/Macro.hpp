@@ -2,11 +2,17 @@
 #define OF_LIB_NODE_MACRO_HPP
 
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util_macro.h>
 #include <OF/utils/CCM.h>
 
+#include <memory>
+#include <type_traits>
+
 #include "Node.hpp"
 #include "Descriptor.hpp"
+#include "Graph.hpp"
 #include "Topic.hpp"
+#include "LoanedTopic.hpp"
 
 
 #define ONE_NODE_REGISTER(UserClass) \
@@ -25,21 +31,236 @@
     STRUCT_SECTION_ITERABLE(node_desc, _desc_##UserClass) ={ \
         .name = UserClass::Meta::name, \
         .thread_id_ptr = &UserClass::tid_storage, \
-        .start_func = &_launcher_##UserClass \
+        .start_func = &_launcher_##UserClass, \
+        .publishes = OF::node_publishes<UserClass::Meta>().data(), \
+        .subscribes = OF::node_subscribes<UserClass::Meta>().data(), \
+        .publish_cnt = static_cast<uint8_t>(OF::node_publishes<UserClass::Meta>().size()), \
+        .subscribe_cnt = static_cast<uint8_t>(OF::node_subscribes<UserClass::Meta>().size()) \
         }
 
-#define ONE_TOPIC_REGISTER(Type, VarName, TopicNameStr) \
+// 以 Topic 名称命名 topic_desc 的输入段，ITERABLE_SECTION_RAM 的 SORT_BY_NAME 会把整个表按名称排好序
+#define ONE_TOPIC_DESC_DEFINE(VarName, TopicNameStr) \
+    static_assert(OF::is_valid_topic_name(TopicNameStr), \
+        "Topic name '" TopicNameStr "' may only contain letters, digits, '_' and '.'"); \
+    Z_DECL_ALIGN(OF::topic_desc) _topic_desc_##VarName \
+        __attribute__((__section__("._topic_desc.static." TopicNameStr))) __used
+
+// 按注册时的实际类型特化一个空函数，ONE_TOPIC_LINK 按声明的类型引用它，类型不一致时链接失败；
+// 以实际类型为参数的重载供 ONE_TOPIC_DECLARE_CHECK 引用，重载与特化不同，声明与定义的先后顺序不受限制
+#define ONE_TOPIC_TYPE_CHECK_DEFINE(VarName) \
+    template <typename TopicT> void _topic_check_##VarName(); \
+    template <> void _topic_check_##VarName<decltype(_topic_instance_##VarName)>() {} \
+    void _topic_decl_check_##VarName(decltype(_topic_instance_##VarName)*) {}
+
+// ONE_TOPIC_DECLARE 一侧：声明 topic_desc 与类型检查函数，供 ONE_NODE_PUBLISHES / ONE_NODE_SUBSCRIBES 引用
+#define ONE_TOPIC_LINK_DECLARE(VarName) \
+    extern OF::topic_desc _topic_desc_##VarName; \
+    template <typename TopicT> void _topic_check_##VarName()
+
+// ONE_TOPIC_DECLARE 一侧：按声明的类型引用类型检查函数，声明与注册的类型或选项不一致时链接失败。
+// 引用放在不占内存的 INFO 段中（见 linker/node_info.ld），不会被 --gc-sections 回收，
+// 因此即使该 Topic 没有出现在 ONE_NODE_PUBLISHES / ONE_NODE_SUBSCRIBES 中也会检查
+#define ONE_TOPIC_DECLARE_CHECK(VarName) \
+    void _topic_decl_check_##VarName(std::remove_cvref_t<decltype(VarName)>*); \
+    static void (*const _topic_check_ref_##VarName)(std::remove_cvref_t<decltype(VarName)>*) \
+        __attribute__((__section__("._topic_check.static." #VarName))) __used = &_topic_decl_check_##VarName
+
+// 开启 CONFIG_TOPIC_GRAPH_PRUNE 后，没有订阅者的 Topic 由 topic_graph.py 定义 OF_TOPIC_PRUNED_<变量名>，
+// 其引用放在 OF::pruned 命名空间中，绕过宏直接写 extern Topic<T>& 的代码会在链接时报错，而不会误用不同的类型
+#define ONE_TOPIC_REF_DEFINE(VarName, TopicType) \
+    COND_CODE_1(OF_TOPIC_PRUNED_##VarName, \
+        (namespace OF::pruned { TopicType& VarName = _topic_instance_##VarName; } using OF::pruned::VarName;), \
+        (TopicType& VarName = _topic_instance_##VarName;))
+
+#define ONE_TOPIC_REF_DECLARE(VarName, TopicType) \
+    COND_CODE_1(OF_TOPIC_PRUNED_##VarName, \
+        (namespace OF::pruned { extern TopicType& VarName; } using OF::pruned::VarName), \
+        (extern TopicType& VarName))
+
+// Topic 实例的存放区域，作为 ONE_TOPIC_REGISTER_IN 的第一个参数：
+// FAST    CCM/DTCM，仅 CPU 访问的数据（默认）
+// DMA     DMA 可访问的 SRAM，供 UART/SPI 等 DMA 直接读写
+// NOCACHE 不经过数据缓存的 SRAM，DMA 与 CPU 共享时无需维护缓存
+#define OF_TOPIC_PLACEMENT_FAST OF_CCM_ATTR
+#define OF_TOPIC_PLACEMENT_DMA OF_DMA_ATTR
+#define OF_TOPIC_PLACEMENT_NOCACHE OF_NOCACHE_ATTR
+
+// 只有真正落在 NOLOAD 段中的实例才在静态初始化阶段重新构造：该段启动时既不加载初值也不清零。
+// 落在普通 .data/.bss 中的实例已经初始化，再构造一次会抹掉其他翻译单元静态初始化时写入的数据。
+// .nocache 仅在开启 CONFIG_NOCACHE_MEMORY 时存在，DMA 段是否为 NOLOAD 由板级的 OF_DMA_NOLOAD 给出
+#define OF_TOPIC_PLACEMENT_INIT_FAST(Instance)
+#define OF_TOPIC_PLACEMENT_INIT_DMA(Instance) COND_CODE_1(OF_DMA_NOLOAD, (OF_TOPIC_CONSTRUCT(Instance)), ())
+#define OF_TOPIC_PLACEMENT_INIT_NOCACHE(Instance) \
+    COND_CODE_1(CONFIG_NOCACHE_MEMORY, (OF_TOPIC_CONSTRUCT(Instance)), ())
+#define OF_TOPIC_CONSTRUCT(Instance) \
+    [[maybe_unused]] static const bool Instance##_constructed = (std::construct_at(&Instance), true);
+
+// 可选参数为 OF::TopicOptions 的指定初始化器，省略时使用默认选项，例如
+// ONE_TOPIC_REGISTER(GimbalData, topic_gimbal, "gimbal_data", .depth = 4, .align = OF::SLOT_ALIGN_PACKED);
+#define ONE_TOPIC_TYPE(Type, ...) OF::Topic<Type __VA_OPT__(, OF::TopicOptions{__VA_ARGS__})>
+#define ONE_TOPIC_PRUNED_TYPE(Type, ...) OF::Topic<Type, OF::TopicOptions{__VA_ARGS__ __VA_OPT__(,) .pruned = true}>
+
+// 按 OF_TOPIC_PRUNED_<变量名> 选择完整或被裁剪的 Topic 类型
+#define ONE_TOPIC_TYPE_OF(VarName, Type, ...) \
+    COND_CODE_1(OF_TOPIC_PRUNED_##VarName, (ONE_TOPIC_PRUNED_TYPE(Type, __VA_ARGS__)), (ONE_TOPIC_TYPE(Type, __VA_ARGS__)))
+
+#define ONE_TOPIC_REGISTER(Type, VarName, TopicNameStr, ...) \
+    ONE_TOPIC_REGISTER_IN(FAST, Type, VarName, TopicNameStr __VA_OPT__(,) __VA_ARGS__)
+
+// 指定存放区域注册 Topic，例如
+// ONE_TOPIC_REGISTER_IN(DMA, RefereeTx, topic_referee_tx, "referee_tx");
+#define ONE_TOPIC_REGISTER_IN(Placement, Type, VarName, TopicNameStr, ...) \
+    \
+    /* Topic instance and reference */ \
+    OF_TOPIC_PLACEMENT_##Placement static ONE_TOPIC_TYPE_OF(VarName, Type, __VA_ARGS__) _topic_instance_##VarName; \
+    OF_TOPIC_PLACEMENT_INIT_##Placement(_topic_instance_##VarName) \
+    ONE_TOPIC_REF_DEFINE(VarName, ONE_TOPIC_TYPE_OF(VarName, Type, __VA_ARGS__)) \
+    ONE_TOPIC_TYPE_CHECK_DEFINE(VarName) \
+    /* register it into global linker section */ \
+    ONE_TOPIC_DESC_DEFINE(VarName, TopicNameStr) = { \
+        .name = TopicNameStr, \
+        .topic_instance = &_topic_instance_##VarName, \
+        .type_size = sizeof(Type),\
+        .footprint = sizeof(_topic_instance_##VarName), \
+        .format_func = decltype(_topic_instance_##VarName)::format_stub, \
+        .meta_func = decltype(_topic_instance_##VarName)::meta_stub, \
+        .stats_func = decltype(_topic_instance_##VarName)::stats_stub, \
+        .write_func = decltype(_topic_instance_##VarName)::write_stub, \
+        .read_func = decltype(_topic_instance_##VarName)::read_stub, \
+        .record_func = decltype(_topic_instance_##VarName)::record_stub, \
+        .status_func = decltype(_topic_instance_##VarName)::status_func, \
+        .attach_func = decltype(_topic_instance_##VarName)::attach_stub, \
+        .deadline_ms = decltype(_topic_instance_##VarName)::options.deadline_ms, \
+        .liveliness_ms = decltype(_topic_instance_##VarName)::options.liveliness_ms, \
+        .multi_writer = decltype(_topic_instance_##VarName)::options.writer == OF::WriterPolicy::Multi \
+    };
+
+// 在其他文件中引用已注册的 Topic，类型与选项必须与 ONE_TOPIC_REGISTER 一致，否则链接报 _topic_decl_check_<变量名> 未定义
+#define ONE_TOPIC_DECLARE(Type, VarName, ...) \
+    ONE_TOPIC_LINK_DECLARE(VarName); \
+    ONE_TOPIC_REF_DECLARE(VarName, ONE_TOPIC_TYPE_OF(VarName, Type, __VA_ARGS__)); \
+    ONE_TOPIC_DECLARE_CHECK(VarName)
+
+#define ONE_QUEUED_TOPIC_REGISTER(Type, VarName, TopicNameStr) \
+    ONE_QUEUED_TOPIC_REGISTER_IN(FAST, Type, VarName, TopicNameStr)
+
+#define ONE_QUEUED_TOPIC_REGISTER_IN(Placement, Type, VarName, TopicNameStr) \
     \
-    /* CCM Topic instance and reference */ \
-    OF_CCM_ATTR static OF::Topic<Type> _topic_instance_##VarName; \
-    OF::Topic<Type>& VarName = _topic_instance_##VarName;\
+    /* QueuedTopic instance and reference */ \
+    OF_TOPIC_PLACEMENT_##Placement static OF::QueuedTopic<Type> _topic_instance_##VarName; \
+    OF_TOPIC_PLACEMENT_INIT_##Placement(_topic_instance_##VarName) \
+    OF::QueuedTopic<Type>& VarName = _topic_instance_##VarName;\
+    ONE_TOPIC_TYPE_CHECK_DEFINE(VarName) \
     /* register it into global linker section */ \
-    STRUCT_SECTION_ITERABLE(topic_desc, _topic_desc_##VarName) = { \
+    ONE_TOPIC_DESC_DEFINE(VarName, TopicNameStr) = { \
         .name = TopicNameStr, \
         .topic_instance = &_topic_instance_##VarName, \
         .type_size = sizeof(Type),\
-        .print_func = OF::Topic<Type>::print_stub \
+        .footprint = sizeof(_topic_instance_##VarName), \
+        .format_func = OF::QueuedTopic<Type>::format_stub, \
+        .meta_func = OF::QueuedTopic<Type>::meta_stub, \
+        .stats_func = OF::QueuedTopic<Type>::stats_stub, \
+        .write_func = OF::QueuedTopic<Type>::write_stub, \
+        .read_func = OF::QueuedTopic<Type>::read_stub, \
+        .record_func = OF::QueuedTopic<Type>::record_stub, \
+        .status_func = nullptr, \
+        .attach_func = OF::QueuedTopic<Type>::attach_stub, \
+        .deadline_ms = 0, \
+        .liveliness_ms = 0, \
+        .multi_writer = false \
     };
 
+#define ONE_QUEUED_TOPIC_DECLARE(Type, VarName) \
+    ONE_TOPIC_LINK_DECLARE(VarName); \
+    extern OF::QueuedTopic<Type>& VarName; \
+    ONE_TOPIC_DECLARE_CHECK(VarName)
+
+// 注册借出式 Topic，可选参数为块池中的块数，省略时为 CONFIG_TOPIC_LOAN_POOL_N，例如
+// ONE_LOANED_TOPIC_REGISTER(VisionTargets, topic_vision_targets, "vision_targets", 6);
+#define ONE_LOANED_TOPIC_TYPE(Type, ...) OF::LoanedTopic<Type __VA_OPT__(, __VA_ARGS__)>
+
+#define ONE_LOANED_TOPIC_REGISTER(Type, VarName, TopicNameStr, ...) \
+    ONE_LOANED_TOPIC_REGISTER_IN(FAST, Type, VarName, TopicNameStr __VA_OPT__(,) __VA_ARGS__)
+
+#define ONE_LOANED_TOPIC_REGISTER_IN(Placement, Type, VarName, TopicNameStr, ...) \
+    \
+    /* LoanedTopic instance and reference */ \
+    OF_TOPIC_PLACEMENT_##Placement static ONE_LOANED_TOPIC_TYPE(Type, __VA_ARGS__) _topic_instance_##VarName; \
+    OF_TOPIC_PLACEMENT_INIT_##Placement(_topic_instance_##VarName) \
+    ONE_LOANED_TOPIC_TYPE(Type, __VA_ARGS__)& VarName = _topic_instance_##VarName;\
+    ONE_TOPIC_TYPE_CHECK_DEFINE(VarName) \
+    /* register it into global linker section */ \
+    ONE_TOPIC_DESC_DEFINE(VarName, TopicNameStr) = { \
+        .name = TopicNameStr, \
+        .topic_instance = &_topic_instance_##VarName, \
+        .type_size = sizeof(Type),\
+        .footprint = sizeof(_topic_instance_##VarName), \
+        .format_func = decltype(_topic_instance_##VarName)::format_stub, \
+        .meta_func = decltype(_topic_instance_##VarName)::meta_stub, \
+        .stats_func = decltype(_topic_instance_##VarName)::stats_stub, \
+        .write_func = decltype(_topic_instance_##VarName)::write_stub, \
+        .read_func = decltype(_topic_instance_##VarName)::read_stub, \
+        .record_func = nullptr, \
+        .status_func = nullptr, \
+        .attach_func = nullptr, \
+        .deadline_ms = 0, \
+        .liveliness_ms = 0, \
+        .multi_writer = true \
+    };
+
+// 块数必须与 ONE_LOANED_TOPIC_REGISTER 一致
+#define ONE_LOANED_TOPIC_DECLARE(Type, VarName, ...) \
+    ONE_TOPIC_LINK_DECLARE(VarName); \
+    extern ONE_LOANED_TOPIC_TYPE(Type, __VA_ARGS__)& VarName; \
+    ONE_TOPIC_DECLARE_CHECK(VarName)
+
+// 静态注册 Topic 回调，Func 的签名为 void(const T&)，T 为 Topic 的数据类型，Mode 为 Inline 或 Deferred，
+// 见 OF::CallbackMode，例如
+// ONE_TOPIC_CALLBACK(topic_referee, on_referee_heat, Inline);
+// Topic 与 ONE_NODE_SUBSCRIBES 一样以变量给出，须已在本文件中注册或通过 ONE_TOPIC_DECLARE 声明；
+// Func 的参数类型不符编译失败，声明与注册的类型不一致链接失败。
+// Func 可以是带命名空间或类名限定的函数，同一函数也可以注册到多个 Topic 上。
+#define ONE_TOPIC_CALLBACK(VarName, Func, Mode) \
+    ONE_TOPIC_CALLBACK_AT(VarName, Func, Mode, __COUNTER__)
+
+// 多一层展开，先把 __COUNTER__ 替换为数字再拼接变量名；变量为 static，不同文件中的编号互不冲突
+#define ONE_TOPIC_CALLBACK_AT(VarName, Func, Mode, Id) \
+    ONE_TOPIC_CALLBACK_DEFINE(VarName, Func, Mode, Id)
+
+#define ONE_TOPIC_CALLBACK_DEFINE(VarName, Func, Mode, Id) \
+    BUILD_ASSERT(IS_ENABLED(CONFIG_TOPIC_CALLBACKS), "ONE_TOPIC_CALLBACK requires CONFIG_TOPIC_CALLBACKS"); \
+    static_assert(OF::CallbackTopic<std::remove_cvref_t<decltype(VarName)>>, \
+        "topic " #VarName " does not support callbacks"); \
+    static Z_DECL_ALIGN(OF::topic_callback) _topic_callback_##Id \
+        __attribute__((__section__("._topic_callback.static." #Func))) __used = { \
+        .link = ONE_TOPIC_LINK(VarName), \
+        .name = #Func, \
+        .mode = OF::CallbackMode::Mode, \
+        .invoke = OF::topic_callback_stub<std::remove_cvref_t<decltype(VarName)>::value_type, Func, \
+            OF::CallbackMode::Mode>, \
+        .next = nullptr, \
+        .work = {} \
+    }
+
+// Topic 图：在 Node 的 Meta 中声明发布与订阅的 Topic，例如
+// struct Meta { ...; ONE_NODE_PUBLISHES(topic_chassis); ONE_NODE_SUBSCRIBES(topic_gimbal, topic_remote); };
+// Topic 须已在本文件中注册或通过 ONE_TOPIC_DECLARE 声明；拼错的变量名编译失败，声明与注册的类型不一致链接失败。
+#define ONE_TOPIC_LINK(VarName) \
+    OF::topic_link{&_topic_desc_##VarName, &_topic_check_##VarName<std::remove_cvref_t<decltype(VarName)>>}
+
+#define ONE_NODE_PUBLISHES(...) \
+    static constexpr OF::topic_link publishes[] = {FOR_EACH(ONE_TOPIC_LINK, (,), __VA_ARGS__)}
+
+#define ONE_NODE_SUBSCRIBES(...) \
+    static constexpr OF::topic_link subscribes[] = {FOR_EACH(ONE_TOPIC_LINK, (,), __VA_ARGS__)}
+
+// 登记 Node 之外的发布者（ISR、驱动等），Name 只用于 Topic 图，例如
+// ONE_TOPIC_PUBLISHER(topic_motor_fb, "can1_rx");
+#define ONE_TOPIC_PUBLISHER(VarName, Name) \
+    Z_DECL_ALIGN(OF::topic_publisher) _topic_publisher_##VarName \
+        __attribute__((__section__("._topic_publisher.static." #VarName))) __used = { \
+        .name = Name, \
+        .link = ONE_TOPIC_LINK(VarName) \
+    }
 
 #endif //OF_LIB_NODE_MACRO_HPP
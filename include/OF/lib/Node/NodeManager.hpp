@@ -1,12 +1,34 @@
 #ifndef OF_LIB_NODEMANAGER_HPP
 #define OF_LIB_NODEMANAGER_HPP
 
+#include <span>
+#include <string_view>
+
 #include "Descriptor.hpp"
 
 
 namespace OF
 {
     void start_all_nodes();
+
+    // 所有已注册的 Topic，按名称升序排列
+    std::span<topic_desc> all_topics();
+
+    /**
+     * @brief 按名称查找 Topic，O(log n) 次字符串比较
+     * @return 找不到时返回 nullptr
+     */
+    topic_desc* find_topic(std::string_view name);
+
+    // check_topic_qos() 对每个未按期发布的 Topic 调用一次
+    typedef void (*topic_qos_cb_t)(const topic_desc& desc, TopicStatus status, void* user_data);
+
+    /**
+     * @brief 检查所有声明了 deadline_ms / liveliness_ms 的 Topic
+     * @param cb 对状态为 Stale / Expired / NoData 的 Topic 调用，可为 nullptr
+     * @return 未按期发布的 Topic 数
+     */
+    size_t check_topic_qos(topic_qos_cb_t cb = nullptr, void* user_data = nullptr);
 }
 
 #endif //OF_LIB_NODEMANAGER_HPP
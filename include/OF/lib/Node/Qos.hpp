@@ -0,0 +1,114 @@
+#ifndef OF_LIB_NODE_QOS_HPP
+#define OF_LIB_NODE_QOS_HPP
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "Descriptor.hpp"
+
+namespace OF
+{
+    /**
+     * @brief Topic 的发布期限与活性检查
+     *
+     * 写入时记录发布时刻（截断为 32 位的系统 tick），读取时与当前 tick 比较一次：
+     * 超过 DeadlineMs 为 Stale，超过 LivelinessMs 为 Expired。32 位 tick 在 10 kHz 下约 5 天回绕一次，
+     * 远大于任何期限，因此写者长时间失效也不会被误判为新鲜。
+     */
+    template <uint32_t DeadlineMs, uint32_t LivelinessMs>
+    class QosMonitor
+    {
+    public:
+        static constexpr bool enabled = true;
+
+        void publish()
+        {
+            atomic_set(&m_last, static_cast<atomic_val_t>(now()));
+        }
+
+        // age_ms 非空时写入距上次发布的毫秒数，与判断状态用的是同一次读取的 tick；从未发布时为 0
+        [[nodiscard]] TopicStatus check(const bool published, uint32_t* age_ms = nullptr) const
+        {
+            if (!published)
+            {
+                if (age_ms != nullptr)
+                {
+                    *age_ms = 0;
+                }
+                return TopicStatus::NoData;
+            }
+            const uint32_t age = now() - static_cast<uint32_t>(atomic_get(&m_last));
+            if (age_ms != nullptr)
+            {
+                *age_ms = k_ticks_to_ms_floor32(age);
+            }
+            if (LivelinessMs != 0 && age > LIVELINESS_TICKS)
+            {
+                return TopicStatus::Expired;
+            }
+            if (DeadlineMs != 0 && age > DEADLINE_TICKS)
+            {
+                return TopicStatus::Stale;
+            }
+            return TopicStatus::Fresh;
+        }
+
+    private:
+        static constexpr uint32_t to_ticks(const uint32_t ms)
+        {
+            return static_cast<uint32_t>(
+                (static_cast<uint64_t>(ms) * CONFIG_SYS_CLOCK_TICKS_PER_SEC + 999U) / 1000U);
+        }
+
+        static uint32_t now()
+        {
+            return static_cast<uint32_t>(k_uptime_ticks());
+        }
+
+        static constexpr uint32_t DEADLINE_TICKS = to_ticks(DeadlineMs);
+        static constexpr uint32_t LIVELINESS_TICKS = to_ticks(LivelinessMs);
+
+        atomic_t m_last = ATOMIC_INIT(0);
+    };
+
+    // 未声明 QoS 时为空类型，配合 [[no_unique_address]] 不占空间，写路径也不读取时钟
+    template <>
+    class QosMonitor<0, 0>
+    {
+    public:
+        static constexpr bool enabled = false;
+
+        void publish()
+        {
+        }
+
+        [[nodiscard]] TopicStatus check(const bool published, uint32_t* age_ms = nullptr) const
+        {
+            if (age_ms != nullptr)
+            {
+                *age_ms = 0;
+            }
+            return published ? TopicStatus::Fresh : TopicStatus::NoData;
+        }
+    };
+
+    constexpr const char* topic_status_str(const TopicStatus status)
+    {
+        switch (status)
+        {
+        case TopicStatus::Fresh:
+            return "fresh";
+        case TopicStatus::Stale:
+            return "stale";
+        case TopicStatus::Expired:
+            return "expired";
+        case TopicStatus::NoData:
+            return "no data";
+        }
+        return "unknown";
+    }
+}
+
+#endif //OF_LIB_NODE_QOS_HPP
@@ -0,0 +1,136 @@
+#ifndef OF_LIB_NODE_RECORDER_HPP
+#define OF_LIB_NODE_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/toolchain.h>
+
+#include "Descriptor.hpp"
+
+namespace OF
+{
+    /*
+     * Topic 录制与回放
+     *
+     * 录制：被选中的 Topic 每次发布时把 {Topic 序号, 时间戳, 数据} 追加到静态 RAM 环中，
+     * 环满后覆盖最旧的记录。停止录制后可通过 shell（topic record dump）导出。
+     *
+     * 导出格式（小端，各字段紧密排列）：
+     *   RecordFileHeader
+     *   topic_cnt 个 {uint16_t type_size; uint8_t name_len; char name[name_len];}，下标即 Topic 序号
+     *   若干 {RecordHeader; uint8_t payload[size];}，按发布时间排列
+     *
+     * 回放：按名称把导出文件中的 Topic 对应到当前固件的 Topic，数据大小一致时通过
+     * topic_desc::write_func 重新发布，可按原始节奏或尽快回放。
+     */
+
+    inline constexpr uint32_t RECORD_FILE_MAGIC = 0x3152464F; // "OFR1"
+
+    struct __packed RecordFileHeader
+    {
+        uint32_t magic;
+        uint32_t cycles_per_sec; // 录制端 k_cycle_get_32() 的频率
+        uint16_t topic_cnt;
+        uint16_t reserved;
+        uint32_t record_bytes; // 紧随 Topic 表之后的记录区总长度
+    };
+
+    struct __packed RecordHeader
+    {
+        uint16_t topic; // Topic 在 all_topics() 中的下标
+        uint16_t size;
+        uint32_t stamp; // k_cycle_get_32()
+    };
+
+    struct RecorderStatus
+    {
+        bool running;
+        uint32_t records; // 环中现存的记录数
+        uint32_t bytes; // 环中现存记录占用的字节数
+        uint32_t overwritten; // 因环满被覆盖的记录数
+    };
+
+    enum class ReplaySpeed : uint8_t
+    {
+        RealTime, // 按录制时的时间间隔发布
+        AsFastAsPossible, // 不等待，依次发布全部记录
+    };
+
+    // 导出回调，data 只在回调期间有效
+    typedef void (*record_sink_t)(const uint8_t* data, size_t len, void* user_data);
+
+    // 以下录制接口由 CONFIG_NODE_RECORDER 提供
+
+    // 选择或取消录制某个 Topic
+    int recorder_select(const topic_desc& desc, bool enable);
+    void recorder_start();
+    void recorder_stop();
+    void recorder_clear();
+    RecorderStatus recorder_status();
+
+    /**
+     * @brief 按导出格式输出当前环中的全部记录
+     * @return 录制仍在进行时返回 -EBUSY
+     */
+    int recorder_dump(record_sink_t sink, void* user_data);
+
+    /**
+     * @brief 把导出文件中的记录重新发布到同名 Topic，由 CONFIG_NODE_REPLAY 提供
+     * @return 发布的记录数；文件格式错误时返回负的错误码
+     */
+    int recorder_replay(std::span<const uint8_t> dump, ReplaySpeed speed);
+
+    // 由 RecordHook 调用，把一次发布追加到录制环
+    void record_sample(const topic_desc* desc, const void* data, size_t size);
+
+#ifdef CONFIG_NODE_RECORDER
+    // Topic 中的录制钩子：未被选中时写路径只多一次原子读
+    class RecordHook
+    {
+    public:
+        void select(const topic_desc* desc)
+        {
+            atomic_ptr_set(&m_desc, const_cast<topic_desc*>(desc));
+        }
+
+        [[nodiscard]] bool active() const
+        {
+            return atomic_ptr_get(&m_desc) != nullptr;
+        }
+
+        void record(const void* data, const size_t size) const
+        {
+            if (const auto* desc = static_cast<const topic_desc*>(atomic_ptr_get(&m_desc)))
+            {
+                record_sample(desc, data, size);
+            }
+        }
+
+    private:
+        atomic_ptr_t m_desc = ATOMIC_PTR_INIT(nullptr);
+    };
+#else
+    // 关闭时为空类型，配合 [[no_unique_address]] 不占空间
+    class RecordHook
+    {
+    public:
+        void select(const topic_desc*)
+        {
+        }
+
+        [[nodiscard]] bool active() const
+        {
+            return false;
+        }
+
+        void record(const void*, size_t) const
+        {
+        }
+    };
+#endif
+}
+
+#endif //OF_LIB_NODE_RECORDER_HPP
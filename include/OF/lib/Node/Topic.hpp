@@ -1,33 +1,149 @@
 #ifndef OF_LIB_NODE_TOPIC_HPP
 #define OF_LIB_NODE_TOPIC_HPP
 
+#include <concepts>
+#include <cstring>
 #include <string>
+#include <type_traits>
+#include <utility>
 
+#include <OF/utils/FormatSink.hpp>
+#include <OF/utils/HistoryBuf.hpp>
 #include <OF/utils/NBuf.hpp>
+#include <OF/utils/QueueBuf.hpp>
+#include <OF/utils/Notifier.hpp>
+#include <OF/lib/Node/Callback.hpp>
 #include <OF/lib/Node/Descriptor.hpp>
+#include <OF/lib/Node/Graph.hpp>
+#include <OF/lib/Node/Qos.hpp>
+#include <OF/lib/Node/Recorder.hpp>
 
 
 namespace OF
 {
+    // 数据类型可选实现 void format(OF::FormatSink& sink) const，供 topic echo 等调试输出使用，例如
+    // void format(OF::FormatSink& sink) const { sink.print("yaw: %d, pitch: %d", yaw, pitch); }
     template <typename T>
-    concept Printable = requires
+    concept Printable = requires(const T& val, FormatSink& sink)
     {
-        { std::declval<T>().format() } -> std::convertible_to<std::string&&>;
+        val.format(sink);
     };
 
+    // 旧接口 std::string format() 每次输出都会分配堆内存，已不再支持
     template <typename T>
+    concept LegacyPrintable = requires(const T& val)
+    {
+        { val.format() } -> std::convertible_to<std::string>;
+    };
+
+    // topic_desc::format_func 的实现，未实现 format() 的类型不输出内容
+    template <typename T>
+    void format_topic_value(FormatSink& sink, const T& val)
+    {
+        static_assert(!LegacyPrintable<T>, "std::string format() is no longer supported, "
+                      "implement void format(OF::FormatSink& sink) const instead");
+
+        if constexpr (Printable<T>)
+        {
+            val.format(sink);
+        }
+    }
+
+    // 各 Topic 类型 print_stub 的实现：经 format_stub 格式化最新样本后以 printk 输出，供没有 shell 的场合调试使用
+    template <typename TopicT>
+    void print_topic_latest(const topic_desc* desc)
+    {
+        char buf[CONFIG_TOPIC_FORMAT_BUF_SIZE];
+        FormatSink sink(buf);
+        const uint32_t seq = TopicT::format_stub(desc, sink);
+        printk("Topic: %-15s | Size: %u | [%u] %s%s\n", desc->name, desc->type_size, seq, sink.c_str(),
+               sink.truncated() ? "..." : "");
+    }
+
+    // 在 ONE_TOPIC_REGISTER 的可选参数中以指定初始化器的形式给出，例如
+    // ONE_TOPIC_REGISTER(GimbalCmd, topic_gimbal_cmd, "gimbal_cmd", .writer = OF::WriterPolicy::Multi);
+    // 指定初始化器必须按成员声明顺序书写。
+    struct TopicOptions
+    {
+        WriterPolicy writer = WriterPolicy::Single;
+        size_t depth = CONFIG_TOPIC_BUFFER_N; // 缓冲槽位数，>= 2；多写者时应大于并发写者数
+        size_t align = SLOT_ALIGN_DEFAULT; // 槽位对齐字节数，SLOT_ALIGN_PACKED 为紧凑排列
+        uint32_t deadline_ms = 0; // 期望的最长发布间隔，超过后状态为 Stale，0 表示不检查
+        uint32_t liveliness_ms = 0; // 超过该时间未发布视为写者失效，状态为 Expired，0 表示不检查
+        size_t history = 0; // 按发布时刻保存的历史样本数，供 sample_at() 回溯，0 表示不保存
+        bool pruned = false; // 没有订阅者，不分配缓冲槽位，由 CONFIG_TOPIC_GRAPH_PRUNE 设置
+    };
+
+    template <typename T, TopicOptions Options>
+    class Subscriber;
+
+    // topic_desc::read_func 的实现，与 write_topic_bytes 对应
+    template <typename T, typename Reader>
+    uint32_t read_topic_bytes(void* out, const Reader& reader)
+    {
+        T val{};
+        const uint32_t seq = reader(val);
+        std::memcpy(out, &val, sizeof(T));
+        return seq;
+    }
+
+    // topic_desc::write_func 的实现：按字节拷贝后发布，供回放等不知道具体类型的场合使用。
+    // 不可平凡拷贝的类型无法从字节重建，忽略写入。
+    template <typename TopicT, typename T>
+    void write_topic_bytes(const topic_desc* desc, const void* data)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            T val;
+            std::memcpy(&val, data, sizeof(T));
+            static_cast<TopicT*>(desc->topic_instance)->write(val);
+        }
+    }
+
+    template <typename T, TopicOptions Options = TopicOptions{}>
     class Topic
     {
+        static_assert(Options.deadline_ms == 0 || Options.liveliness_ms == 0 ||
+                      Options.liveliness_ms >= Options.deadline_ms,
+                      "liveliness_ms must not be shorter than deadline_ms");
+        static_assert(Options.history == 0 || Options.writer == WriterPolicy::Single,
+                      "topic history supports a single writer only");
+
     public:
-        void write(const T& data)
+        using value_type = T;
+        static constexpr TopicOptions options = Options;
+
+        // 返回本次发布的序号
+        uint32_t write(const T& data)
         {
-            m_buf.write(data);
+            const uint32_t seq = m_buf.write(data);
+            push_history(data);
+            m_qos.publish();
+            m_callbacks.dispatch(&data);
+            m_record.record(&data, sizeof(T));
+            m_notifier.notify();
+            return seq;
         }
 
         template <typename Func>
-        void manipulate(const Func& func)
+        uint32_t manipulate(const Func& func)
         {
-            m_buf.manipulate(func);
+            return publish_in_place(func, [this](const auto& f) { return m_buf.manipulate(f); });
+        }
+
+        // 以最新样本为起点原地修改后发布，见 NBuf::update
+        template <typename Func>
+        uint32_t update(const Func& func)
+        {
+            return publish_in_place(func, [this](const auto& f) { return m_buf.update(f); });
+        }
+
+        // 只更新数组型数据中的一个元素，见 NBuf::update_at
+        template <typename E>
+        uint32_t update_at(const size_t index, const E& value)
+            requires requires(T& data) { data[index] = value; }
+        {
+            return update([index, &value](T& data) { data[index] = value; });
         }
 
         std::optional<T> try_read()
@@ -40,20 +156,451 @@ namespace OF
             return m_buf.read();
         }
 
+        Sample<T> read_with_meta()
+        {
+            return m_buf.read_with_meta();
+        }
+
+        uint32_t read_into(T& out)
+        {
+            return m_buf.read_into(out);
+        }
+
+        // 读取序号为 seq 的历史样本，已被覆盖时返回 false，见 NBuf::read_at
+        bool read_at(const uint32_t seq, T& out) const
+        {
+            return m_buf.read_at(seq, out);
+        }
+
+        // 不会因写者被抢占而等待的读取，返回 0 表示读取失败，见 NBuf::read_into_wait_free
+        uint32_t read_into_wait_free(T& out)
+        {
+            return m_buf.read_into_wait_free(out);
+        }
+
+        /**
+         * @brief 读取最新样本并返回其 QoS 状态
+         *
+         * 数据照常写入 out，由调用者决定 Stale / Expired 时是否仍然使用；从未发布时不触碰 out。
+         */
+        TopicStatus read_checked(T& out)
+        {
+            static_assert(!Options.pruned, "pruned topic has no subscribers, see ONE_NODE_SUBSCRIBES");
+            if (m_buf.generation() == 0)
+            {
+                return TopicStatus::NoData;
+            }
+            m_buf.read_into(out);
+            return m_qos.check(true);
+        }
+
+        /**
+         * @brief 取过去某一时刻的值，在前后两次发布之间插值，见 HistoryBuf::sample_at
+         * @param stamp k_cycle_get_32() 周期数，与 Sample::stamp 同一时基；恰为某次发布的 stamp 时返回该次发布的值
+         */
+        std::optional<T> sample_at(const uint32_t stamp) const
+            requires (Options.history > 0)
+        {
+            static_assert(!Options.pruned, "pruned topic has no subscribers, see ONE_NODE_SUBSCRIBES");
+            return m_history.sample_at(stamp);
+        }
+
+        // 不读取数据，只判断最新样本的 QoS 状态
+        [[nodiscard]] TopicStatus status() const
+        {
+            static_assert(!Options.pruned, "pruned topic has no subscribers, see ONE_NODE_SUBSCRIBES");
+            return m_qos.check(m_buf.generation() != 0);
+        }
+
+        /**
+         * @brief 零拷贝读取：在最新槽位上直接执行 func(const T&)，撕裂读时会重试，见 NBuf::visit
+         */
+        template <typename Func>
+            requires std::invocable<Func&, const T&>
+        auto read(Func&& func)
+        {
+            return m_buf.visit(std::forward<Func>(func));
+        }
+
+        [[nodiscard]] uint32_t generation() const
+        {
+            return m_buf.generation();
+        }
+
+        /**
+         * @brief 阻塞等待世代号离开 seen，即等待 seen 之后的下一次发布
+         * @param seen 调用者上次看到的世代号，返回 true 时更新为最新世代号
+         * @param timeout 最长等待时间
+         * @return 有新发布返回 true，超时返回 false
+         */
+        bool wait_next(uint32_t& seen, k_timeout_t timeout)
+        {
+            static_assert(!Options.pruned, "pruned topic has no subscribers, see ONE_NODE_SUBSCRIBES");
+            m_notifier.wait_while([this, seen] { return m_buf.generation() == seen; }, timeout);
+
+            const uint32_t gen = m_buf.generation();
+            if (gen == seen)
+            {
+                return false;
+            }
+            seen = gen;
+            return true;
+        }
+
+        /**
+         * @brief 阻塞等待调用之后的下一次发布
+         */
+        bool wait_next(k_timeout_t timeout)
+        {
+            uint32_t seen = m_buf.generation();
+            return wait_next(seen, timeout);
+        }
+
+        // 创建记录已读序号的订阅句柄，见 Subscriber
+        Subscriber<T, Options> subscribe()
+        {
+            static_assert(!Options.pruned, "pruned topic has no subscribers, see ONE_NODE_SUBSCRIBES");
+            return Subscriber<T, Options>(*this);
+        }
+
+        // 发布唤醒器，供 wait_any() 等同时等待多个 Topic 的场合使用
+        Notifier& notifier()
+        {
+            return m_notifier;
+        }
+
         static void print_stub(const topic_desc* desc)
+        {
+            print_topic_latest<Topic>(desc);
+        }
+
+        static uint32_t format_stub(const topic_desc* desc, FormatSink& sink)
+        {
+            if constexpr (Options.pruned)
+            {
+                sink.append("pruned");
+                return 0;
+            }
+            else
+            {
+                auto* self = static_cast<Topic*>(desc->topic_instance);
+                T val{};
+                const uint32_t seq = self->read_into(val);
+                format_topic_value(sink, val);
+                return seq;
+            }
+        }
+
+        static topic_meta meta_stub(const topic_desc* desc)
+        {
+            const auto* self = static_cast<const Topic*>(desc->topic_instance);
+            const auto [seq, stamp] = self->m_buf.read_meta();
+            return {seq, stamp};
+        }
+
+        static void write_stub(const topic_desc* desc, const void* data)
+        {
+            write_topic_bytes<Topic, T>(desc, data);
+        }
+
+        static uint32_t read_stub(const topic_desc* desc, void* out)
+        {
+            if constexpr (Options.pruned)
+            {
+                return 0;
+            }
+            else
+            {
+                auto* self = static_cast<Topic*>(desc->topic_instance);
+                return read_topic_bytes<T>(out, [self](T& val) { return self->read_into(val); });
+            }
+        }
+
+        static void record_stub(const topic_desc* desc, const bool enable)
+        {
+            static_cast<Topic*>(desc->topic_instance)->m_record.select(enable ? desc : nullptr);
+        }
+
+        static TopicStatus status_stub(const topic_desc* desc, uint32_t* age_ms)
+        {
+            const auto* self = static_cast<const Topic*>(desc->topic_instance);
+            return self->m_qos.check(self->m_buf.generation() != 0, age_ms);
+        }
+
+        // 注册到 topic_desc 的 status_func，未声明 QoS 或已被裁剪时为 nullptr，全局检查可直接跳过
+        static constexpr status_func_t status_func = []
+        {
+            if constexpr (QosMonitor<Options.deadline_ms, Options.liveliness_ms>::enabled && !Options.pruned)
+            {
+                return static_cast<status_func_t>(status_stub);
+            }
+            else
+            {
+                return static_cast<status_func_t>(nullptr);
+            }
+        }();
+
+        static void attach_stub(const topic_desc* desc, topic_callback* cb)
+        {
+            static_cast<Topic*>(desc->topic_instance)->m_callbacks.attach(cb);
+        }
+
+        static BufStatsSnapshot stats_stub(const topic_desc* desc, const bool reset)
         {
             auto* self = static_cast<Topic*>(desc->topic_instance);
-            T val = self->read();
-            printk("Topic: %-15s | Size: %d | ", desc->name, sizeof(T));
-            if constexpr (Printable<T>)
+            const BufStatsSnapshot stats = self->m_buf.stats();
+            if (reset)
+            {
+                self->m_buf.reset_stats();
+            }
+            return stats;
+        }
+
+    private:
+        // manipulate() 与 update() 共用：通过 commit 在写入窗口内执行 func，再完成回调、录制与唤醒
+        template <typename Func, typename Commit>
+        uint32_t publish_in_place(const Func& func, const Commit& commit)
+        {
+            if (HISTORY_N > 0 || !m_callbacks.empty() || m_record.active())
+            {
+                // 回调与录制在提交之后执行，因此在写入窗口内复制一份，多写者时也不会交付别人的发布；
+                // 录制要取录制器的自旋锁，放在写入窗口外不拉长读者的重试窗口
+                T committed;
+                const uint32_t seq = commit([&func, &committed](T& data)
+                {
+                    func(data);
+                    committed = data;
+                });
+                push_history(committed);
+                m_qos.publish();
+                m_callbacks.dispatch(&committed);
+                m_record.record(&committed, sizeof(T));
+                m_notifier.notify();
+                return seq;
+            }
+
+            const uint32_t seq = commit(func);
+            m_qos.publish();
+            m_notifier.notify();
+            return seq;
+        }
+
+        // 历史样本复用刚提交的槽位的时间戳，sample_at(read_with_meta().stamp) 恰好返回该样本
+        void push_history(const T& data)
+        {
+            if constexpr (HISTORY_N > 0)
+            {
+                m_history.push(m_buf.last_commit().stamp, data);
+            }
+        }
+
+        // 被裁剪的 Topic 不含缓冲槽位，见 PrunedBuf
+        using Buffer = std::conditional_t<Options.pruned, PrunedBuf<T>,
+                                          NBuf<T, Options.depth, Options.writer, Options.align>>;
+
+        // 被裁剪的 Topic 没有读者，也不保存历史
+        static constexpr size_t HISTORY_N = Options.pruned ? 0 : Options.history;
+
+        [[no_unique_address]] Buffer m_buf;
+        [[no_unique_address]] HistoryBuf<T, HISTORY_N> m_history;
+        Notifier m_notifier;
+        [[no_unique_address]] QosMonitor<Options.deadline_ms, Options.liveliness_ms> m_qos;
+        [[no_unique_address]] CallbackList m_callbacks;
+        [[no_unique_address]] RecordHook m_record;
+    };
+
+    /**
+     * @brief 记住上次读到的发布序号的轻量订阅句柄
+     *
+     * read_if_new() 在没有新发布时只比较一次世代号，既不拷贝数据也不进入 seqlock 循环，
+     * 适合高频循环消费低频输入。新建的句柄会把 Topic 中已有的数据视为新数据。
+     */
+    template <typename T, TopicOptions Options = TopicOptions{}>
+    class Subscriber
+    {
+    public:
+        explicit Subscriber(Topic<T, Options>& topic) :
+            m_topic(topic)
+        {
+        }
+
+        [[nodiscard]] bool has_new() const
+        {
+            return m_topic.generation() != m_seen;
+        }
+
+        std::optional<T> read_if_new()
+        {
+            if (!has_new())
+            {
+                return std::nullopt;
+            }
+            std::optional<T> val{std::in_place};
+            m_seen = m_topic.read_into(*val);
+            return val;
+        }
+
+        // 有新发布时写入 out 并返回 true，否则不触碰 out
+        bool read_if_new(T& out)
+        {
+            if (!has_new())
+            {
+                return false;
+            }
+            m_seen = m_topic.read_into(out);
+            return true;
+        }
+
+        // 阻塞直到出现尚未读取的发布，不改变已读序号
+        bool wait(k_timeout_t timeout)
+        {
+            uint32_t seen = m_seen;
+            return m_topic.wait_next(seen, timeout);
+        }
+
+        [[nodiscard]] uint32_t last_seq() const
+        {
+            return m_seen;
+        }
+
+        [[nodiscard]] Topic<T, Options>& topic() const
+        {
+            return m_topic;
+        }
+
+    private:
+        Topic<T, Options>& m_topic;
+        uint32_t m_seen{0};
+    };
+
+    /**
+     * @brief 无损队列 Topic，适用于按键、裁判系统事件等不能丢中间值的数据
+     *
+     * 写者把样本追加到 CONFIG_TOPIC_QUEUE_N 深的环中且从不阻塞；每个订阅者持有自己的
+     * Cursor，poll() 按发布顺序交付上次读取之后的全部样本，落后超过队列深度时以丢失计数报告。
+     * 只支持单个写者。
+     */
+    template <typename T>
+    class QueuedTopic
+    {
+    public:
+        using value_type = T;
+        using Buffer = QueueBuf<T, CONFIG_TOPIC_QUEUE_N>;
+        using Cursor = typename Buffer::Cursor;
+        using PollResult = typename Buffer::PollResult;
+
+        void write(const T& data)
+        {
+            m_buf.write(data);
+            m_callbacks.dispatch(&data);
+            m_record.record(&data, sizeof(T));
+            m_notifier.notify();
+        }
+
+        // 订阅者从订阅之后的第一条发布开始接收
+        [[nodiscard]] Cursor subscribe() const
+        {
+            return m_buf.subscribe();
+        }
+
+        template <typename Func>
+            requires std::invocable<Func&, const T&>
+        PollResult poll(Cursor& cursor, Func&& func, const uint32_t max = UINT32_MAX) const
+        {
+            return m_buf.poll(cursor, func, max);
+        }
+
+        /**
+         * @brief 阻塞直到 cursor 之后有新样本
+         * @return 有新样本返回 true，超时返回 false
+         */
+        bool wait(const Cursor& cursor, k_timeout_t timeout)
+        {
+            m_notifier.wait_while([this, &cursor] { return !m_buf.has_new(cursor); }, timeout);
+            return m_buf.has_new(cursor);
+        }
+
+        // 读取最新一条样本，不移动任何 Cursor
+        T read() const
+        {
+            return m_buf.latest();
+        }
+
+        [[nodiscard]] bool has_new(const Cursor& cursor) const
+        {
+            return m_buf.has_new(cursor);
+        }
+
+        // 最新一次发布的序号，从未发布时为 0
+        [[nodiscard]] uint32_t generation() const
+        {
+            return m_buf.head();
+        }
+
+        // 发布唤醒器，供 wait_any() 等同时等待多个 Topic 的场合使用
+        Notifier& notifier()
+        {
+            return m_notifier;
+        }
+
+        static void print_stub(const topic_desc* desc)
+        {
+            print_topic_latest<QueuedTopic>(desc);
+        }
+
+        static uint32_t format_stub(const topic_desc* desc, FormatSink& sink)
+        {
+            auto* self = static_cast<QueuedTopic*>(desc->topic_instance);
+            T val{};
+            const uint32_t seq = self->m_buf.latest_into(val);
+            format_topic_value(sink, val);
+            return seq;
+        }
+
+        static topic_meta meta_stub(const topic_desc* desc)
+        {
+            const auto* self = static_cast<const QueuedTopic*>(desc->topic_instance);
+            const auto [seq, stamp] = self->m_buf.latest_meta();
+            return {seq, stamp};
+        }
+
+        static void write_stub(const topic_desc* desc, const void* data)
+        {
+            write_topic_bytes<QueuedTopic, T>(desc, data);
+        }
+
+        static uint32_t read_stub(const topic_desc* desc, void* out)
+        {
+            const auto* self = static_cast<const QueuedTopic*>(desc->topic_instance);
+            return read_topic_bytes<T>(out, [self](T& val) { return self->m_buf.latest_into(val); });
+        }
+
+        static void record_stub(const topic_desc* desc, const bool enable)
+        {
+            static_cast<QueuedTopic*>(desc->topic_instance)->m_record.select(enable ? desc : nullptr);
+        }
+
+        static void attach_stub(const topic_desc* desc, topic_callback* cb)
+        {
+            static_cast<QueuedTopic*>(desc->topic_instance)->m_callbacks.attach(cb);
+        }
+
+        static BufStatsSnapshot stats_stub(const topic_desc* desc, const bool reset)
+        {
+            auto* self = static_cast<QueuedTopic*>(desc->topic_instance);
+            const BufStatsSnapshot stats = self->m_buf.stats();
+            if (reset)
             {
-                printk("%s", val.format().c_str());
+                self->m_buf.reset_stats();
             }
-            printk("\n");
+            return stats;
         }
 
     private:
-        NBuf<T, CONFIG_TOPIC_BUFFER_N> m_buf;
+        Buffer m_buf;
+        Notifier m_notifier;
+        [[no_unique_address]] CallbackList m_callbacks;
+        [[no_unique_address]] RecordHook m_record;
     };
 }
 
@@ -0,0 +1,146 @@
+#ifndef OF_LIB_NODE_WAITANY_HPP
+#define OF_LIB_NODE_WAITANY_HPP
+
+#include <bitset>
+#include <tuple>
+#include <utility>
+
+#include <zephyr/kernel.h>
+
+#include <OF/utils/Notifier.hpp>
+
+#include "Topic.hpp"
+
+namespace OF
+{
+    namespace detail
+    {
+        // wait_any() 的等待源：Topic 与 QueuedTopic 以调用时的世代号为基准，Subscriber 以其已读序号为基准
+        template <typename Source>
+        struct WaitSource;
+
+        template <typename T, TopicOptions Options>
+        struct WaitSource<Topic<T, Options>>
+        {
+            static uint32_t baseline(const Topic<T, Options>& topic)
+            {
+                return topic.generation();
+            }
+
+            static bool has_new(const Topic<T, Options>& topic, const uint32_t baseline)
+            {
+                return topic.generation() != baseline;
+            }
+
+            static Notifier& notifier(Topic<T, Options>& topic)
+            {
+                return topic.notifier();
+            }
+        };
+
+        template <typename T>
+        struct WaitSource<QueuedTopic<T>>
+        {
+            static uint32_t baseline(const QueuedTopic<T>& topic)
+            {
+                return topic.generation();
+            }
+
+            static bool has_new(const QueuedTopic<T>& topic, const uint32_t baseline)
+            {
+                return topic.generation() != baseline;
+            }
+
+            static Notifier& notifier(QueuedTopic<T>& topic)
+            {
+                return topic.notifier();
+            }
+        };
+
+        template <typename T, TopicOptions Options>
+        struct WaitSource<Subscriber<T, Options>>
+        {
+            static uint32_t baseline(const Subscriber<T, Options>&)
+            {
+                return 0;
+            }
+
+            static bool has_new(const Subscriber<T, Options>& sub, uint32_t)
+            {
+                return sub.has_new();
+            }
+
+            static Notifier& notifier(Subscriber<T, Options>& sub)
+            {
+                return sub.topic().notifier();
+            }
+        };
+    }
+
+    /**
+     * @brief 阻塞直到任一 Topic 有新发布，或超时
+     *
+     * 参数可以是 Topic、QueuedTopic、LoanedTopic（等待调用之后的发布）或 Subscriber（等待其尚未读取的发布）；
+     * QueuedTopic 被唤醒后用各自的 Cursor poll() 取出样本。
+     * 所有 Topic 的 Notifier 共用调用者栈上的同一个信号量，发布路径与单独等待时相同，不引入 k_poll。
+     * 不读取数据、不改变 Subscriber 的已读序号，例如：
+     *
+     *   const auto ready = OF::wait_any(K_MSEC(10), imu_sub, vision_sub, topic_remote);
+     *   if (ready.test(0)) { imu_sub.read_if_new(imu); }
+     *
+     * @return 第 i 位表示第 i 个参数有新发布，超时返回全 0
+     */
+    template <typename... Sources>
+    std::bitset<sizeof...(Sources)> wait_any(const k_timeout_t timeout, Sources&... sources)
+    {
+        static_assert(sizeof...(Sources) > 0, "wait_any needs at least one topic");
+        constexpr size_t N = sizeof...(Sources);
+
+        auto refs = std::tie(sources...);
+        uint32_t baselines[N];
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            ((baselines[I] = detail::WaitSource<Sources>::baseline(std::get<I>(refs))), ...);
+        }(std::index_sequence_for<Sources...>{});
+
+        const auto ready = [&]
+        {
+            std::bitset<N> result;
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (result.set(I, detail::WaitSource<Sources>::has_new(std::get<I>(refs), baselines[I])), ...);
+            }(std::index_sequence_for<Sources...>{});
+            return result;
+        };
+
+        if (auto result = ready(); result.any())
+        {
+            return result;
+        }
+
+        k_sem sem;
+        k_sem_init(&sem, 0, 1);
+        Notifier::Waiter waiters[N];
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            ((waiters[I].sem = &sem, detail::WaitSource<Sources>::notifier(std::get<I>(refs)).attach(waiters[I])),
+                ...);
+        }(std::index_sequence_for<Sources...>{});
+
+        // 先挂上等待者再检查，挂上之前的发布会在这里被看到，之后的发布会释放信号量
+        auto result = ready();
+        if (result.none())
+        {
+            (void)k_sem_take(&sem, timeout);
+            result = ready();
+        }
+
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (detail::WaitSource<Sources>::notifier(std::get<I>(refs)).detach(waiters[I]), ...);
+        }(std::index_sequence_for<Sources...>{});
+        return result;
+    }
+}
+
+#endif //OF_LIB_NODE_WAITANY_HPP
@@ -0,0 +1,326 @@
+#ifndef OF_BLOCKPOOL_HPP
+#define OF_BLOCKPOOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/kernel.h>
+
+#include <OF/utils/NBuf.hpp>
+
+namespace OF
+{
+    // 池中的一个数据块，引用计数为 0 表示空闲
+    template <typename T>
+    struct LoanBlock
+    {
+        atomic_t refs = ATOMIC_INIT(0);
+        uint32_t size{0}; // 写者填写的有效字节数，定长数据为 sizeof(T)
+        uint32_t seq{0}; // 发布序号，未发布时为 0
+        uint32_t stamp{0}; // 发布时刻，k_cycle_get_32() 周期数
+        T data;
+
+        // 仅在引用计数不为 0 时加一；块已被归还时返回 false
+        bool try_retain() noexcept
+        {
+            atomic_val_t refs_now = atomic_get(&refs);
+            while (refs_now != 0)
+            {
+                if (atomic_cas(&refs, refs_now, refs_now + 1))
+                {
+                    return true;
+                }
+                refs_now = atomic_get(&refs);
+            }
+            return false;
+        }
+
+        void retain() noexcept
+        {
+            atomic_inc(&refs);
+        }
+
+        // 减到 0 时块即回到池中，atomic_dec 同时保证此前对数据的访问已经完成
+        void release() noexcept
+        {
+            atomic_dec(&refs);
+        }
+    };
+
+    /**
+     * @brief 写者独占的数据块，只能移动
+     *
+     * 块中是上一次使用留下的数据，写者需自行填写全部字段；未发布就析构时块直接回到池中。
+     */
+    template <typename T>
+    class Loan
+    {
+    public:
+        Loan() = default;
+
+        explicit Loan(LoanBlock<T>* block) noexcept :
+            m_block(block)
+        {
+        }
+
+        Loan(const Loan&) = delete;
+        Loan& operator=(const Loan&) = delete;
+
+        Loan(Loan&& other) noexcept :
+            m_block(std::exchange(other.m_block, nullptr))
+        {
+        }
+
+        Loan& operator=(Loan&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_block = std::exchange(other.m_block, nullptr);
+            }
+            return *this;
+        }
+
+        ~Loan()
+        {
+            reset();
+        }
+
+        // 池已耗尽时借出的 Loan 为空
+        explicit operator bool() const noexcept
+        {
+            return m_block != nullptr;
+        }
+
+        T* get() const noexcept
+        {
+            return &m_block->data;
+        }
+
+        T* operator->() const noexcept
+        {
+            return get();
+        }
+
+        T& operator*() const noexcept
+        {
+            return *get();
+        }
+
+        // 变长数据实际使用的字节数，不超过 sizeof(T)
+        void set_size(const size_t bytes) noexcept
+        {
+            m_block->size = static_cast<uint32_t>(std::min(bytes, sizeof(T)));
+        }
+
+        // 交出块的所有权，由发布者接管这份引用
+        LoanBlock<T>* detach() noexcept
+        {
+            return std::exchange(m_block, nullptr);
+        }
+
+        void reset() noexcept
+        {
+            if (m_block != nullptr)
+            {
+                m_block->release();
+                m_block = nullptr;
+            }
+        }
+
+    private:
+        LoanBlock<T>* m_block{nullptr};
+    };
+
+    /**
+     * @brief 已发布数据块的只读共享句柄
+     *
+     * 复制句柄只增加引用计数，不拷贝数据；最后一个句柄析构时块回到池中。
+     * 持有句柄期间块不会被复用，长期持有会占用池中的块，导致写者借不到块。
+     */
+    template <typename T>
+    class Shared
+    {
+    public:
+        Shared() = default;
+
+        // 接管 block 上已经持有的一份引用
+        explicit Shared(LoanBlock<T>* block) noexcept :
+            m_block(block)
+        {
+        }
+
+        Shared(const Shared& other) noexcept :
+            m_block(other.m_block)
+        {
+            if (m_block != nullptr)
+            {
+                m_block->retain();
+            }
+        }
+
+        Shared& operator=(const Shared& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_block = other.m_block;
+                if (m_block != nullptr)
+                {
+                    m_block->retain();
+                }
+            }
+            return *this;
+        }
+
+        Shared(Shared&& other) noexcept :
+            m_block(std::exchange(other.m_block, nullptr))
+        {
+        }
+
+        Shared& operator=(Shared&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_block = std::exchange(other.m_block, nullptr);
+            }
+            return *this;
+        }
+
+        ~Shared()
+        {
+            reset();
+        }
+
+        // 从未发布时为空
+        explicit operator bool() const noexcept
+        {
+            return m_block != nullptr;
+        }
+
+        const T* get() const noexcept
+        {
+            return &m_block->data;
+        }
+
+        const T* operator->() const noexcept
+        {
+            return get();
+        }
+
+        const T& operator*() const noexcept
+        {
+            return *get();
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return m_block->size;
+        }
+
+        [[nodiscard]] uint32_t seq() const noexcept
+        {
+            return m_block->seq;
+        }
+
+        [[nodiscard]] uint32_t stamp() const noexcept
+        {
+            return m_block->stamp;
+        }
+
+        void reset() noexcept
+        {
+            if (m_block != nullptr)
+            {
+                m_block->release();
+                m_block = nullptr;
+            }
+        }
+
+    private:
+        LoanBlock<T>* m_block{nullptr};
+    };
+
+    /**
+     * @brief 静态分配、带引用计数的定长块池
+     *
+     * loan() 用 CAS 把某个空闲块的引用计数从 0 改为 1，可在 ISR 与多个线程中并发调用，从不阻塞；
+     * 池耗尽时返回空的 Loan 并计数。块按 Align 对齐，默认与 NBuf 槽位一致。
+     */
+    template <typename T, size_t Count, size_t Align = SLOT_ALIGN_DEFAULT>
+        requires std::is_standard_layout_v<T> && (Count >= 2) && ((Align & (Align - 1)) == 0)
+    class BlockPool
+    {
+    public:
+        using Block = LoanBlock<T>;
+
+        BlockPool() = default;
+
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator=(const BlockPool&) = delete;
+
+        Loan<T> loan() noexcept
+        {
+            // 从上次借出的位置之后开始查找，通常一次 CAS 即可借到
+            const auto start = static_cast<size_t>(atomic_get(&m_hint));
+            for (size_t i = 0; i < Count; ++i)
+            {
+                const size_t idx = (start + i) % Count;
+                Block& block = m_blocks[idx].block;
+                if (atomic_cas(&block.refs, 0, 1))
+                {
+                    atomic_set(&m_hint, static_cast<atomic_val_t>((idx + 1) % Count));
+                    block.size = sizeof(T);
+                    block.seq = 0;
+                    return Loan<T>(&block);
+                }
+            }
+            atomic_inc(&m_failures);
+            return {};
+        }
+
+        [[nodiscard]] Block& block(const size_t idx) noexcept
+        {
+            return m_blocks[idx].block;
+        }
+
+        [[nodiscard]] size_t index_of(const Block* block) const noexcept
+        {
+            return reinterpret_cast<const Slot*>(block) - m_blocks.data();
+        }
+
+        // 当前空闲的块数，只作为统计参考
+        [[nodiscard]] size_t available() const noexcept
+        {
+            return std::count_if(m_blocks.begin(), m_blocks.end(),
+                                 [](const Slot& slot) { return atomic_get(&slot.block.refs) == 0; });
+        }
+
+        // 因池耗尽而借出失败的次数
+        [[nodiscard]] uint32_t failures() const noexcept
+        {
+            return static_cast<uint32_t>(atomic_get(&m_failures));
+        }
+
+        static constexpr size_t capacity()
+        {
+            return Count;
+        }
+
+    private:
+        struct alignas (std::max({Align, alignof(Block)})) Slot
+        {
+            Block block;
+        };
+
+        std::array<Slot, Count> m_blocks;
+        atomic_t m_hint = ATOMIC_INIT(0);
+        atomic_t m_failures = ATOMIC_INIT(0);
+    };
+}
+
+#endif //OF_BLOCKPOOL_HPP
@@ -0,0 +1,115 @@
+#ifndef OF_BUFSTATS_HPP
+#define OF_BUFSTATS_HPP
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/kernel.h>
+
+namespace OF
+{
+    struct BufStatsSnapshot
+    {
+        uint32_t writes;
+        uint32_t reads;
+        uint32_t retries; // 读到撕裂数据后重读的次数
+        uint32_t yields; // 遇到正在写入的槽位而 k_yield() 的次数
+        uint32_t max_read_cyc; // 单次读取的最坏耗时（周期数），包含重试与让出
+    };
+
+#ifdef CONFIG_TOPIC_STATS
+    // NBuf / SeqlockBuf 的竞争统计，由 CONFIG_TOPIC_STATS 开启
+    class BufStats
+    {
+    public:
+        static constexpr bool enabled = true;
+
+        static uint32_t now()
+        {
+            return k_cycle_get_32();
+        }
+
+        void on_write()
+        {
+            atomic_inc(&m_writes);
+        }
+
+        void on_read(const uint32_t retries, const uint32_t yields, const uint32_t start_cyc)
+        {
+            const auto elapsed = static_cast<atomic_val_t>(k_cycle_get_32() - start_cyc);
+            atomic_inc(&m_reads);
+            if (retries != 0)
+            {
+                atomic_add(&m_retries, static_cast<atomic_val_t>(retries));
+            }
+            if (yields != 0)
+            {
+                atomic_add(&m_yields, static_cast<atomic_val_t>(yields));
+            }
+
+            atomic_val_t max = atomic_get(&m_max_read_cyc);
+            while (static_cast<uint32_t>(elapsed) > static_cast<uint32_t>(max) &&
+                !atomic_cas(&m_max_read_cyc, max, elapsed))
+            {
+                max = atomic_get(&m_max_read_cyc);
+            }
+        }
+
+        [[nodiscard]] BufStatsSnapshot snapshot() const
+        {
+            return {
+                static_cast<uint32_t>(atomic_get(&m_writes)),
+                static_cast<uint32_t>(atomic_get(&m_reads)),
+                static_cast<uint32_t>(atomic_get(&m_retries)),
+                static_cast<uint32_t>(atomic_get(&m_yields)),
+                static_cast<uint32_t>(atomic_get(&m_max_read_cyc)),
+            };
+        }
+
+        void reset()
+        {
+            atomic_clear(&m_writes);
+            atomic_clear(&m_reads);
+            atomic_clear(&m_retries);
+            atomic_clear(&m_yields);
+            atomic_clear(&m_max_read_cyc);
+        }
+
+    private:
+        atomic_t m_writes = ATOMIC_INIT(0);
+        atomic_t m_reads = ATOMIC_INIT(0);
+        atomic_t m_retries = ATOMIC_INIT(0);
+        atomic_t m_yields = ATOMIC_INIT(0);
+        atomic_t m_max_read_cyc = ATOMIC_INIT(0);
+    };
+#else
+    // 关闭时为空类型，配合 [[no_unique_address]] 不占空间，所有调用都会被优化掉
+    class BufStats
+    {
+    public:
+        static constexpr bool enabled = false;
+
+        static uint32_t now()
+        {
+            return 0;
+        }
+
+        void on_write()
+        {
+        }
+
+        void on_read(uint32_t, uint32_t, uint32_t)
+        {
+        }
+
+        [[nodiscard]] BufStatsSnapshot snapshot() const
+        {
+            return {};
+        }
+
+        void reset()
+        {
+        }
+    };
+#endif
+}
+
+#endif //OF_BUFSTATS_HPP
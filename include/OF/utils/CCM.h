@@ -2,6 +2,7 @@
 #define OF_CCM_H
 
 #include <zephyr/kernel.h>
+#include <zephyr/linker/section_tags.h>
 
 #if DT_HAS_CHOSEN(zephyr_dtcm)
 #define OF_CCM_ATTR __dtcm_data_section
@@ -12,4 +13,19 @@
 #define OF_CCM_ATTR
 #endif
 
+// DMA 可访问的 SRAM，默认即普通 RAM；主 RAM 不能被 DMA 访问的板子可在编译选项中改为指定段
+#ifndef OF_DMA_ATTR
+#define OF_DMA_ATTR
+#endif
+
+// OF_DMA_ATTR 指定的段为 NOLOAD（启动时既不加载初值也不清零）时需同时定义为 1
+#ifndef OF_DMA_NOLOAD
+#define OF_DMA_NOLOAD 0
+#endif
+
+// 不经过数据缓存的 SRAM，需要 CONFIG_NOCACHE_MEMORY，未开启时 __nocache 为空（即使用默认的 RAM）
+#ifndef OF_NOCACHE_ATTR
+#define OF_NOCACHE_ATTR __nocache
+#endif
+
 #endif //OF_CCM_H
@@ -0,0 +1,126 @@
+#ifndef OF_UTILS_EPOCHGROUP_HPP
+#define OF_UTILS_EPOCHGROUP_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include <zephyr/sys/atomic.h>
+
+#include <OF/utils/SmpFence.hpp>
+
+namespace OF
+{
+    /**
+     * @brief 把多个 NBuf / Topic 的发布组织为同一个 epoch，读者可取得属于同一 epoch 的快照
+     *
+     * 提交时依次写入各成员，并记下每个成员本次发布的序号；读者先取得最近一次完成的 epoch 对应的
+     * 序号表，再用 read_at() 按序号读取各成员的历史样本。写路径只多两次原子自增，没有锁；
+     * 提交进行中的读者直接使用上一个 epoch，只有样本在读取期间被覆盖时才重试。
+     *
+     * 成员需提供 value_type、uint32_t write(const value_type&) 与 bool read_at(uint32_t, value_type&)。
+     * 同一时刻只能有一个线程调用 commit()；成员也可以在组外单独发布，但会更快地覆盖快照所需的历史样本，
+     * 成员的缓冲深度应大于两次提交之间可能发生的组外发布次数，否则 snapshot() 会失败并返回 0。
+     */
+    template <typename... Members>
+    class EpochGroup
+    {
+        static constexpr size_t N = sizeof...(Members);
+        static_assert(N > 0, "EpochGroup needs at least one member");
+
+    public:
+        explicit EpochGroup(Members&... members) :
+            m_members(members...)
+        {
+        }
+
+        EpochGroup(const EpochGroup&) = delete;
+        EpochGroup& operator=(const EpochGroup&) = delete;
+
+        /**
+         * @brief 按成员顺序写入一组样本，作为一个新的 epoch 提交
+         * @return 本次提交的 epoch，从 1 开始递增
+         */
+        uint32_t commit(const typename Members::value_type&... values)
+        {
+            // 状态为奇数表示提交进行中，epoch = 状态 / 2
+            const auto state = static_cast<uint32_t>(atomic_get(&m_state));
+            const uint32_t epoch = (state >> 1) + 1;
+            uint32_t* seqs = m_seqs[epoch & 1];
+
+            atomic_inc(&m_state);
+            smp_write_fence();
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                ((seqs[I] = std::get<I>(m_members).write(values)), ...);
+            }(std::index_sequence_for<Members...>{});
+            smp_write_fence();
+            atomic_inc(&m_state);
+            return epoch;
+        }
+
+        /**
+         * @brief 读取最近一次完成提交的全部成员样本
+         *
+         * 读取期间有新的提交完成时改读新的 epoch；没有新提交而样本已被组外发布覆盖时不再等待，直接失败。
+         * @return 快照所属的 epoch；从未提交时返回 0，此时 out 不被修改；
+         *         最近一个 epoch 的样本已被覆盖时返回 0，此时 out 可能已被部分改写
+         */
+        uint32_t snapshot(typename Members::value_type&... out) const
+        {
+            while (true)
+            {
+                const auto state = static_cast<uint32_t>(atomic_get(&m_state));
+                const uint32_t epoch = state >> 1;
+                if (epoch == 0)
+                {
+                    return 0;
+                }
+
+                uint32_t seqs[N];
+                smp_read_fence();
+                for (size_t i = 0; i < N; ++i)
+                {
+                    seqs[i] = m_seqs[epoch & 1][i];
+                }
+                smp_read_fence();
+
+                // epoch + 2 的提交开始后会改写同一张序号表，此前拷贝的序号表仍然有效
+                const auto now = static_cast<uint32_t>(atomic_get(&m_state));
+                if (now - (state & ~1U) > 2)
+                {
+                    continue;
+                }
+
+                const bool ok = [&, outs = std::tie(out...)]<size_t... I>(std::index_sequence<I...>)
+                {
+                    return (std::get<I>(m_members).read_at(seqs[I], std::get<I>(outs)) && ...);
+                }(std::index_sequence_for<Members...>{});
+                if (ok)
+                {
+                    return epoch;
+                }
+
+                // 没有新的提交可读，样本是被组外发布覆盖的，重试也读不到
+                if (static_cast<uint32_t>(atomic_get(&m_state)) == state)
+                {
+                    return 0;
+                }
+            }
+        }
+
+        // 最近一次完成提交的 epoch，0 表示从未提交
+        [[nodiscard]] uint32_t epoch() const
+        {
+            return static_cast<uint32_t>(atomic_get(&m_state)) >> 1;
+        }
+
+    private:
+        std::tuple<Members&...> m_members;
+        // 按 epoch 的奇偶交替使用，提交进行中时读者仍可读取上一个 epoch 的序号表
+        uint32_t m_seqs[2][N]{};
+        atomic_t m_state = ATOMIC_INIT(0);
+    };
+}
+
+#endif //OF_UTILS_EPOCHGROUP_HPP
@@ -0,0 +1,109 @@
+#ifndef OF_UTILS_FORMATSINK_HPP
+#define OF_UTILS_FORMATSINK_HPP
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include <zephyr/sys/printk.h>
+#include <zephyr/toolchain.h>
+
+namespace OF
+{
+    /**
+     * @brief 向调用者提供的定长缓冲区追加格式化文本，不使用堆
+     *
+     * 超出缓冲区的内容被截断，缓冲区始终以 '\0' 结尾。格式由 vsnprintk 解析，
+     * 浮点数需要开启 CONFIG_CBPRINTF_FP_SUPPORT。
+     */
+    class FormatSink
+    {
+    public:
+        explicit FormatSink(const std::span<char> buf) :
+            m_buf(buf)
+        {
+            if (!m_buf.empty())
+            {
+                m_buf[0] = '\0';
+            }
+        }
+
+        FormatSink(const FormatSink&) = delete;
+        FormatSink& operator=(const FormatSink&) = delete;
+
+        __printf_like(2, 3) FormatSink& print(const char* fmt, ...)
+        {
+            va_list args;
+            va_start(args, fmt);
+            vprint(fmt, args);
+            va_end(args);
+            return *this;
+        }
+
+        FormatSink& vprint(const char* fmt, va_list args)
+        {
+            if (m_buf.size() <= m_len + 1)
+            {
+                m_truncated = true;
+                return *this;
+            }
+            const size_t avail = m_buf.size() - m_len;
+            const int ret = vsnprintk(&m_buf[m_len], avail, fmt, args);
+            if (ret < 0)
+            {
+                m_buf[m_len] = '\0';
+            }
+            else if (static_cast<size_t>(ret) >= avail)
+            {
+                m_len = m_buf.size() - 1;
+                m_truncated = true;
+            }
+            else
+            {
+                m_len += ret;
+            }
+            return *this;
+        }
+
+        FormatSink& append(const std::string_view str)
+        {
+            if (m_buf.empty())
+            {
+                m_truncated = !str.empty();
+                return *this;
+            }
+            const size_t len = std::min(str.size(), m_buf.size() - 1 - m_len);
+            std::memcpy(&m_buf[m_len], str.data(), len);
+            m_len += len;
+            m_buf[m_len] = '\0';
+            m_truncated |= len < str.size();
+            return *this;
+        }
+
+        [[nodiscard]] std::string_view view() const
+        {
+            return {m_buf.data(), m_len};
+        }
+
+        [[nodiscard]] const char* c_str() const
+        {
+            return m_buf.empty() ? "" : m_buf.data();
+        }
+
+        // 是否有内容因缓冲区已满被丢弃
+        [[nodiscard]] bool truncated() const
+        {
+            return m_truncated;
+        }
+
+    private:
+        std::span<char> m_buf;
+        size_t m_len{0};
+        bool m_truncated{false};
+    };
+}
+
+#endif //OF_UTILS_FORMATSINK_HPP
@@ -0,0 +1,221 @@
+#ifndef OF_HISTORYBUF_HPP
+#define OF_HISTORYBUF_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/kernel.h>
+
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/SmpFence.hpp>
+
+namespace OF
+{
+    // 数据类型可选实现 T interpolate(const T& to, float alpha) const，供 HistoryBuf::sample_at 在两个样本间插值，
+    // alpha 为 0 时返回自身，为 1 时返回 to；四元数等需要球面插值的类型应自行实现
+    template <typename T>
+    concept Interpolatable = requires(const T& a, const T& b, float alpha)
+    {
+        { a.interpolate(b, alpha) } -> std::convertible_to<T>;
+    };
+
+    // 算术类型线性插值，实现了 interpolate() 的类型调用其实现，其余类型取时间上更近的样本。
+    // 整数在 double 中计算后四舍五入，无符号数递减时不会回绕，结果介于两个样本之间
+    template <typename T>
+    T interpolate_sample(const T& from, const T& to, const float alpha)
+    {
+        if constexpr (Interpolatable<T>)
+        {
+            return from.interpolate(to, alpha);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return static_cast<T>(from + (to - from) * alpha);
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            const auto from_d = static_cast<double>(from);
+            return static_cast<T>(std::round(from_d + (static_cast<double>(to) - from_d) * alpha));
+        }
+        else
+        {
+            return alpha < 0.5f ? from : to;
+        }
+    }
+
+    /**
+     * @brief 按时间索引的历史样本环，用于把传感器数据对齐到过去的某一时刻（如相机曝光时刻）
+     *
+     * 保存最近 N 个带时间戳的样本，时间戳为 k_cycle_get_32() 周期数，与 Sample::stamp 一致，
+     * 比较时按回绕差值处理，可回溯的时长应远小于 32 位周期计数的回绕周期。
+     * 单写者，push() 的时间戳应单调不减；读者无锁，写者在查找期间写入时重试。
+     */
+    template <typename T, size_t N>
+    class HistoryBuf
+    {
+        static_assert(N >= 2, "HistoryBuf needs at least 2 samples to interpolate");
+
+    public:
+        using value_type = T;
+
+        void push(const uint32_t stamp, const T& value)
+        {
+            m_stats.on_write();
+
+            auto& entry = m_entries[m_head];
+
+            // 与 SeqlockBuf 相同：版本号为奇数期间读者重试
+            atomic_inc(&m_version);
+            smp_write_fence();
+            entry.stamp = stamp;
+            entry.value = value;
+            m_head = (m_head + 1) % N;
+            if (m_count < N)
+            {
+                ++m_count;
+            }
+            smp_write_fence();
+            atomic_inc(&m_version);
+        }
+
+        /**
+         * @brief 取 stamp 时刻的值，在前后两个样本之间插值，二分查找 O(log N)
+         *
+         * 比最新样本更新的时刻返回最新样本；比保存的最旧样本还旧或尚无样本时返回空。
+         */
+        std::optional<T> sample_at(const uint32_t stamp) const
+        {
+            const uint32_t start = BufStats::now();
+            uint32_t retries{}, yields{};
+            while (true)
+            {
+                const auto v1 = atomic_get(&m_version);
+                if (v1 & 1)
+                {
+                    ++yields;
+                    k_yield();
+                    continue;
+                }
+
+                smp_read_fence();
+                const std::optional<T> val = lookup(stamp);
+                smp_read_fence();
+
+                if (atomic_get(&m_version) == v1)
+                {
+                    m_stats.on_read(retries, yields, start);
+                    return val;
+                }
+                ++retries;
+            }
+        }
+
+        // 当前保存的样本数，只作为统计参考
+        [[nodiscard]] size_t size() const
+        {
+            return m_count;
+        }
+
+        static constexpr size_t capacity()
+        {
+            return N;
+        }
+
+        [[nodiscard]] BufStatsSnapshot stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+        void reset_stats()
+        {
+            m_stats.reset();
+        }
+
+    private:
+        struct Entry
+        {
+            uint32_t stamp{0};
+            T value{};
+        };
+
+        // 回绕安全的时间比较：a 不晚于 b
+        static bool not_after(const uint32_t a, const uint32_t b)
+        {
+            return static_cast<int32_t>(a - b) <= 0;
+        }
+
+        // 第 i 旧的样本，i 为 0 时是最旧的样本
+        const Entry& at(const size_t i) const
+        {
+            return m_entries[(m_head + N - m_count + i) % N];
+        }
+
+        // 只在读者的版本号检查之间调用，读到的内容可能已被写者改写，由调用者丢弃
+        std::optional<T> lookup(const uint32_t stamp) const
+        {
+            const size_t count = m_count;
+            if (count == 0 || count > N)
+            {
+                return std::nullopt;
+            }
+
+            const Entry& newest = at(count - 1);
+            if (not_after(newest.stamp, stamp))
+            {
+                return newest.value;
+            }
+            if (!not_after(at(0).stamp, stamp))
+            {
+                return std::nullopt;
+            }
+
+            // 找到最后一个不晚于 stamp 的样本，它与下一个样本夹住 stamp
+            size_t lo = 0, hi = count - 1;
+            while (hi - lo > 1)
+            {
+                const size_t mid = lo + (hi - lo) / 2;
+                if (not_after(at(mid).stamp, stamp))
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+
+            const Entry& from = at(lo);
+            const Entry& to = at(hi);
+            const uint32_t span = to.stamp - from.stamp;
+            if (span == 0)
+            {
+                return to.value;
+            }
+            const float alpha = static_cast<float>(stamp - from.stamp) / static_cast<float>(span);
+            return interpolate_sample(from.value, to.value, alpha);
+        }
+
+        std::array<Entry, N> m_entries{};
+        size_t m_head{0};
+        size_t m_count{0};
+        atomic_t m_version = ATOMIC_INIT(0);
+        [[no_unique_address]] mutable BufStats m_stats;
+    };
+
+    // 不保存历史，供 TopicOptions::history 为 0 时以 [[no_unique_address]] 成员形式零开销嵌入
+    template <typename T>
+    class HistoryBuf<T, 0>
+    {
+    public:
+        void push(uint32_t, const T&)
+        {
+        }
+    };
+}
+
+#endif //OF_HISTORYBUF_HPP
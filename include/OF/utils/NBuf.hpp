@@ -2,22 +2,72 @@
 #define OF_TRIPLEBUF_HPP
 
 #include <new>
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/kernel.h>
 
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/SmpFence.hpp>
+
 #include <optional>
+#include <type_traits>
 
 using std::hardware_destructive_interference_size;
 
 namespace OF
 {
-    // SPMC N-Buffer Class
-    template <typename T, size_t N>
-        requires std::is_standard_layout_v<T> && (N >= 2)
+    template <typename T>
+    struct Sample
+    {
+        T data;
+        uint32_t seq; // 发布序号，从 1 开始递增，0 表示从未发布
+        uint32_t stamp; // 发布时刻，k_cycle_get_32() 周期数
+    };
+
+    // 不含数据的样本元信息，用于统计发布频率等场合
+    struct SampleMeta
+    {
+        uint32_t seq;
+        uint32_t stamp;
+    };
+
+    enum class WriterPolicy : uint8_t
+    {
+        Single, // 只有一个写者（线程或 ISR），写路径无 CAS
+        Multi, // 多个写者并发发布，通过 CAS 抢占槽位；并发写者数应小于 N
+    };
+
+    // 槽位紧凑排列，只满足成员自身的对齐要求
+    inline constexpr size_t SLOT_ALIGN_PACKED = 0;
+
+    // 槽位默认对齐：有数据缓存或多核时按缓存行对齐以避免伪共享；
+    // 无缓存的单核 MCU（如 STM32F4）上填充没有收益，紧凑排列。
+#if defined(CONFIG_DCACHE_LINE_SIZE) && CONFIG_DCACHE_LINE_SIZE > 0
+    inline constexpr size_t SLOT_ALIGN_DEFAULT = CONFIG_DCACHE_LINE_SIZE;
+#elif defined(CONFIG_DCACHE) || defined(CONFIG_SMP)
+#ifdef __GNUC__
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+    inline constexpr size_t SLOT_ALIGN_DEFAULT = hardware_destructive_interference_size;
+#ifdef __GNUC__
+#  pragma GCC diagnostic pop
+#endif
+#else
+    inline constexpr size_t SLOT_ALIGN_DEFAULT = SLOT_ALIGN_PACKED;
+#endif
+
+    // N-Buffer Class, SPMC by default, MPMC with WriterPolicy::Multi
+    // Align 为每个槽位的对齐字节数，SLOT_ALIGN_PACKED 表示不额外填充
+    template <typename T, size_t N, WriterPolicy Writer = WriterPolicy::Single, size_t Align = SLOT_ALIGN_DEFAULT>
+        requires std::is_standard_layout_v<T> && (N >= 2) && ((Align & (Align - 1)) == 0)
     class NBuf
     {
     public:
+        using value_type = T;
+
         NBuf() = default;
 
         NBuf(const NBuf&) = delete;
@@ -25,47 +75,87 @@ namespace OF
         NBuf(NBuf&& other) = delete;
         NBuf& operator =(NBuf&& other) = delete;
 
-        void write(const T& data) noexcept
+        // 返回本次发布的序号
+        uint32_t write(const T& data) noexcept
         {
-            auto next_slot = (m_next_write_idx + 1) % N;
-            auto& slot = m_slots[next_slot];
-            atomic_inc(&slot.version);
-            compiler_barrier();
-            slot.data = data;
-            compiler_barrier();
-            atomic_inc(&slot.version);
+            return commit([&data](T& slot_data) { slot_data = data; });
+        }
 
-            atomic_set(&m_latest_idx, next_slot);
-            m_next_write_idx = next_slot;
+        template <typename Func>
+        uint32_t manipulate(const Func& func)
+        {
+            return commit(func);
         }
 
+        /**
+         * @brief 以最新样本为起点原地修改并发布
+         *
+         * manipulate() 交给 func 的是下一个槽位，其中是 N - 1 次发布之前的旧数据；
+         * update() 先把最新槽位拷贝进下一个槽位，再在其上执行 func(T&)，只比 write() 多一次槽位内拷贝，
+         * 省去 read() 加 write() 的两次整体拷贝和栈上的临时对象。
+         * WriterPolicy::Multi 下不加锁：拷贝之后若有其他写者先完成了发布，则从新的最新样本重新拷贝并再次执行 func，
+         * 并发修改不同字段时不会互相覆盖，与 write() / manipulate() 混用也不会丢失修改。
+         * 因此 func 可能被调用多次，只应修改传入的数据。
+         * @return 本次发布的序号
+         */
         template <typename Func>
-        void manipulate(const Func& func)
+        uint32_t update(const Func& func)
         {
-            auto next_slot = (m_next_write_idx + 1) % N;
-            auto& slot = m_slots[next_slot];
+            if constexpr (Writer == WriterPolicy::Multi)
+            {
+                m_stats.on_write();
+                return update_multi(func);
+            }
+            else
+            {
+                return commit([this, &func](T& slot_data)
+                {
+                    // 单写者时最新槽位不会在拷贝期间被改写
+                    slot_data = m_slots[latest_idx()].data;
+                    func(slot_data);
+                });
+            }
+        }
 
-            atomic_inc(&slot.version);
-            compiler_barrier();
-            func(slot.data);
-            compiler_barrier();
-            atomic_inc(&slot.version);
+        /**
+         * @brief 只更新数组型数据中的一个元素，其余元素保持最新样本中的值
+         *
+         * 用于由多个写者各自负责一个元素的 Topic，例如每路电机的 CAN 接收回调只写自己的反馈。
+         */
+        template <typename E>
+        uint32_t update_at(const size_t index, const E& value)
+            requires requires(T& data) { data[index] = value; }
+        {
+            return update([index, &value](T& slot_data) { slot_data[index] = value; });
+        }
 
+        // 读写竞争统计，CONFIG_TOPIC_STATS 关闭时恒为 0
+        [[nodiscard]] BufStatsSnapshot stats() const noexcept
+        {
+            return m_stats.snapshot();
+        }
+
+        void reset_stats() noexcept
+        {
+            m_stats.reset();
+        }
 
-            atomic_set(&m_latest_idx, next_slot);
-            m_next_write_idx = next_slot;
+        // 已提交的写入次数，即最新一次发布的序号
+        [[nodiscard]] uint32_t generation() const noexcept
+        {
+            return static_cast<uint32_t>(atomic_get(&m_generation));
         }
 
         std::optional<T> try_read() const noexcept
         {
             T out_data;
-            auto& slot = m_slots[atomic_get(&m_latest_idx)];
+            auto& slot = m_slots[latest_idx()];
 
             auto v1 = atomic_get(&slot.version);
 
-            compiler_barrier();
+            smp_read_fence();
             out_data = slot.data;
-            compiler_barrier();
+            smp_read_fence();
 
             auto v2 = atomic_get(&slot.version);
             return v1 == v2 ? out_data : std::nullopt;
@@ -76,47 +166,421 @@ namespace OF
         T read() const noexcept
         {
             T copy{};
-            auto& slot = m_slots[atomic_get(&m_latest_idx)];
-            atomic_val_t v1, v2{};
-            do
+            read_into(copy);
+            return copy;
+        }
+
+        // 直接写入调用者提供的存储，省去按值返回的临时对象；返回该样本的发布序号
+        uint32_t read_into(T& out) const noexcept
+        {
+            uint32_t seq{};
+            read_latest([&out, &seq](const Slot& slot)
             {
-                v1 = atomic_get(&slot.version);
+                out = slot.data;
+                seq = slot.seq;
+            });
+            return seq;
+        }
 
-                if (v1 & 1)
+        /**
+         * @brief 无等待读取，适合高优先级读者读取低优先级写者发布的数据
+         *
+         * 最新槽位正被写入或读到撕裂数据时，不让出 CPU 也不在同一槽位上重试，
+         * 而是立即回退到序号更早的最新完整槽位，最多尝试 N 次。
+         * 因此读到的样本可能比上一次读到的更旧，调用者可根据返回的序号判断。
+         * @return 样本的发布序号；从未发布或 N 次尝试全部失败时返回 0，此时 out 的内容不可用
+         */
+        uint32_t read_into_wait_free(T& out) const noexcept
+        {
+            uint32_t seq{};
+            read_wait_free([&out, &seq](const Slot& slot)
+            {
+                out = slot.data;
+                seq = slot.seq;
+            });
+            return seq;
+        }
+
+        /**
+         * @brief 读取序号为 seq 的样本，不等待
+         *
+         * 该样本已被覆盖（其后又发布了 N - 1 次以上）、正被覆盖或尚未发布时返回 false，此时 out 的内容不可用。
+         */
+        bool read_at(const uint32_t seq, T& out) const noexcept
+        {
+            for (const auto& slot : m_slots)
+            {
+                const auto v1 = atomic_get(&slot.version);
+                if ((v1 & 1) || slot.seq != seq || seq == 0)
                 {
-                    k_yield();
                     continue;
                 }
 
-                compiler_barrier();
-                copy = slot.data;
-                compiler_barrier();
+                smp_read_fence();
+                out = slot.data;
+                const uint32_t got = slot.seq;
+                smp_read_fence();
 
-                v2 = atomic_get(&slot.version);
+                // 序号唯一，找到的槽位在读取期间被改写即说明该样本已不存在
+                return atomic_get(&slot.version) == v1 && got == seq;
             }
-            while (v1 != v2);
+            return false;
+        }
+
+        // 读取最新数据及其发布序号、发布时间戳
+        Sample<T> read_with_meta() const noexcept
+        {
+            Sample<T> copy{};
+            read_latest([&copy](const Slot& slot)
+            {
+                copy.data = slot.data;
+                copy.seq = slot.seq;
+                copy.stamp = slot.stamp;
+            });
             return copy;
         }
 
+        // 写者读取自己刚提交的样本的序号与时间戳：单写者时最新槽位只会被它自己改写，无需读循环，也不计入读取统计
+        [[nodiscard]] SampleMeta last_commit() const noexcept
+            requires (Writer == WriterPolicy::Single)
+        {
+            const auto& slot = m_slots[latest_idx()];
+            return {slot.seq, slot.stamp};
+        }
+
+        // 只读取最新样本的序号与时间戳，不拷贝数据
+        SampleMeta read_meta() const noexcept
+        {
+            SampleMeta meta{};
+            read_latest([&meta](const Slot& slot)
+            {
+                meta.seq = slot.seq;
+                meta.stamp = slot.stamp;
+            });
+            return meta;
+        }
+
+        /**
+         * @brief 在槽位上原地执行 func(const T&)，不拷贝整个数据
+         *
+         * 读到被写者撕裂的数据时 func 会被重新调用，因此 func 不应产生副作用，
+         * 且要能容忍一次不一致的输入（例如不要用读到的值做无检查的数组下标）。
+         * @return 最后一次（数据一致的）调用的返回值
+         */
+        template <typename Func>
+        auto visit(Func&& func) const
+        {
+            using Ret = std::invoke_result_t<Func&, const T&>;
+            if constexpr (std::is_void_v<Ret>)
+            {
+                read_latest([&func](const Slot& slot) { func(slot.data); });
+            }
+            else
+            {
+                Ret ret{};
+                read_latest([&func, &ret](const Slot& slot) { ret = func(slot.data); });
+                return ret;
+            }
+        }
+
     private:
-#ifdef __GNUC__
-#  pragma GCC diagnostic push
-#  pragma GCC diagnostic ignored "-Winterference-size"
-#endif
-        struct alignas (hardware_destructive_interference_size) Slot
+        // seqlock 读循环：版本号为奇数或前后不一致时重试 func
+        template <typename Func>
+        void read_latest(const Func& func) const
+        {
+            auto& slot = m_slots[latest_idx()];
+            const uint32_t start = BufStats::now();
+            uint32_t retries{}, yields{};
+            while (true)
+            {
+                const auto v1 = atomic_get(&slot.version);
+
+                if (v1 & 1)
+                {
+                    ++yields;
+                    k_yield();
+                    continue;
+                }
+
+                smp_read_fence();
+                func(slot);
+                smp_read_fence();
+
+                if (atomic_get(&slot.version) == v1)
+                {
+                    break;
+                }
+                ++retries;
+            }
+            m_stats.on_read(retries, yields, start);
+        }
+
+        // 无等待读取：每个槽位只尝试一次，失败后换到序号更早的完整槽位，返回是否读到一致的数据
+        template <typename Func>
+        bool read_wait_free(const Func& func) const
+        {
+            const uint32_t start = BufStats::now();
+            uint32_t retries{};
+            auto idx = latest_idx();
+            uint32_t bound{};
+
+            for (size_t attempt = 0; attempt < N; ++attempt)
+            {
+                const auto& slot = m_slots[idx];
+                const auto v1 = atomic_get(&slot.version);
+                if (!(v1 & 1))
+                {
+                    smp_read_fence();
+                    func(slot);
+                    smp_read_fence();
+
+                    if (atomic_get(&slot.version) == v1)
+                    {
+                        m_stats.on_read(retries, 0, start);
+                        return true;
+                    }
+                }
+                ++retries;
+
+                // 序号只作为挑选候选槽位的依据，读到的值即使过期也不影响正确性
+                const uint32_t failed_seq = slot.seq;
+                bound = (attempt == 0 || is_newer(bound, failed_seq)) ? failed_seq : bound;
+                if (!find_older(bound, idx))
+                {
+                    break;
+                }
+            }
+            m_stats.on_read(retries, 0, start);
+            return false;
+        }
+
+        // 在版本号为偶数的槽位中查找序号早于 bound 的最新一个
+        bool find_older(const uint32_t bound, size_t& idx) const
+        {
+            bool found = false;
+            uint32_t best{};
+            for (size_t i = 0; i < N; ++i)
+            {
+                const auto& slot = m_slots[i];
+                const uint32_t seq = slot.seq;
+                if ((atomic_get(&slot.version) & 1) || seq == 0 || !is_newer(bound, seq))
+                {
+                    continue;
+                }
+                if (!found || is_newer(seq, best))
+                {
+                    found = true;
+                    best = seq;
+                    idx = i;
+                }
+            }
+            return found;
+        }
+
+        template <typename Func>
+        uint32_t commit(const Func& func)
+        {
+            m_stats.on_write();
+            if constexpr (Writer == WriterPolicy::Multi)
+            {
+                return commit_multi(func);
+            }
+            else
+            {
+                auto next_slot = (m_next_write_idx + 1) % N;
+                auto& slot = m_slots[next_slot];
+                const auto seq = static_cast<uint32_t>(atomic_get(&m_generation)) + 1;
+
+                atomic_inc(&slot.version);
+                smp_write_fence();
+                func(slot.data);
+                slot.seq = seq;
+                slot.stamp = k_cycle_get_32();
+                smp_write_fence();
+                atomic_inc(&slot.version);
+
+                atomic_set(&m_latest, pack_latest(seq, next_slot));
+                m_next_write_idx = next_slot;
+                atomic_set(&m_generation, seq);
+                return seq;
+            }
+        }
+
+        template <typename Func>
+        uint32_t commit_multi(const Func& func)
+        {
+            // 1. 领取全局递增的发布序号
+            const auto seq = claim_seq();
+
+            // 2. 领取一个空闲槽位，见 claim_slot()
+            const size_t idx = claim_slot(seq);
+            auto& slot = m_slots[idx];
+            smp_write_fence();
+            func(slot.data);
+            slot.seq = seq;
+            slot.stamp = k_cycle_get_32();
+            smp_write_fence();
+            atomic_inc(&slot.version);
+
+            // 3. 只有比当前最新样本更新的发布才能推进 m_latest，迟到的旧样本直接丢弃。
+            // 序号与槽位号在同一个原子字中比较和替换，不读取其他槽位的非原子序号
+            const auto packed = pack_latest(seq, idx);
+            while (true)
+            {
+                const auto cur = atomic_get(&m_latest);
+                if (!is_newer(static_cast<uint32_t>(packed) & ~IDX_MASK, static_cast<uint32_t>(cur) & ~IDX_MASK)
+                    || atomic_cas(&m_latest, cur, packed))
+                {
+                    break;
+                }
+            }
+            advance_generation(seq);
+            return seq;
+        }
+
+        // 多写者的 update()：在领取的槽位中拷贝最新样本并执行 func，只有最新样本在此期间没有变化时才发布，
+        // 否则重新拷贝。槽位在发布之前一直保持奇数版本号，其他写者不会领取它；全程不持有锁，让出 CPU 时不会阻塞其他写者
+        template <typename Func>
+        uint32_t update_multi(const Func& func)
+        {
+            auto seq = claim_seq();
+            const size_t idx = claim_slot(seq);
+            auto& slot = m_slots[idx];
+
+            while (true)
+            {
+                const auto cur = atomic_get(&m_latest);
+                // 序号必须比被替换的样本新，否则读者会看到序号回退；重新领取的序号总比已发布的新
+                if (!is_newer(seq << IDX_BITS, static_cast<uint32_t>(cur) & ~IDX_MASK))
+                {
+                    seq = claim_seq();
+                }
+
+                const auto& src = m_slots[static_cast<uint32_t>(cur) & IDX_MASK];
+                const auto v = atomic_get(&src.version);
+                if (v & 1)
+                {
+                    k_yield();
+                    continue;
+                }
+                smp_read_fence();
+                slot.data = src.data;
+                smp_read_fence();
+                if (atomic_get(&src.version) != v || atomic_get(&m_latest) != cur)
+                {
+                    continue;
+                }
+
+                func(slot.data);
+                slot.seq = seq;
+                slot.stamp = k_cycle_get_32();
+                smp_write_fence();
+                if (atomic_cas(&m_latest, cur, pack_latest(seq, idx)))
+                {
+                    break;
+                }
+            }
+
+            // m_latest 已指向该槽位，版本号变为偶数后读者即可读取
+            atomic_inc(&slot.version);
+            advance_generation(seq);
+            return seq;
+        }
+
+        uint32_t claim_seq()
+        {
+            return static_cast<uint32_t>(atomic_inc(&m_claim_seq)) + 1;
+        }
+
+        /**
+         * 从 seq % N 开始，用 CAS 把某个空闲槽位的版本号从偶数改为奇数，返回槽位号。
+         * 最新槽位、以及已写完但尚未成为最新的槽位（序号比最新样本新）都不能领取，
+         * 否则读者可能读到比上一次更旧的样本；一轮扫描没有可用槽位时让出 CPU 后重新扫描。
+         * 每个写者最多占住一个槽位，并发写者数小于 N 时总有可用槽位。
+         */
+        size_t claim_slot(const uint32_t seq)
+        {
+            size_t idx = seq % N;
+            for (size_t tries = 1;; ++tries, idx = (idx + 1) % N)
+            {
+                auto& cand = m_slots[idx];
+                const auto v = atomic_get(&cand.version);
+                if (!(v & 1))
+                {
+                    // 版本号在 CAS 成功前没有变化，读到的序号即属于该版本
+                    smp_read_fence();
+                    const uint32_t cand_seq = cand.seq;
+                    const auto cur = static_cast<uint32_t>(atomic_get(&m_latest));
+                    if ((cur & IDX_MASK) != idx
+                        && !is_newer(cand_seq << IDX_BITS, cur & ~IDX_MASK)
+                        && atomic_cas(&cand.version, v, v + 1))
+                    {
+                        return idx;
+                    }
+                }
+                if (tries % N == 0)
+                {
+                    k_yield();
+                }
+            }
+        }
+
+        void advance_generation(const uint32_t seq)
+        {
+            while (true)
+            {
+                const auto gen = atomic_get(&m_generation);
+                if (!is_newer(seq, static_cast<uint32_t>(gen)) || atomic_cas(&m_generation, gen, seq))
+                {
+                    break;
+                }
+            }
+        }
+
+        // a 是否比 b 更新（允许序号回绕）
+        static constexpr bool is_newer(const uint32_t a, const uint32_t b)
+        {
+            return static_cast<int32_t>(a - b) > 0;
+        }
+
+        // m_latest 低 IDX_BITS 位为最新槽位号，其余位为其发布序号的低位，
+        // 比较序号时只需两者的差小于 2^(31 - IDX_BITS)，远大于同时在途的写者数
+        static constexpr unsigned IDX_BITS = std::bit_width(N - 1);
+        static constexpr uint32_t IDX_MASK = (1U << IDX_BITS) - 1;
+
+        static constexpr atomic_val_t pack_latest(const uint32_t seq, const size_t idx)
+        {
+            return static_cast<atomic_val_t>((seq << IDX_BITS) | static_cast<uint32_t>(idx));
+        }
+
+        size_t latest_idx() const
+        {
+            return static_cast<uint32_t>(atomic_get(&m_latest)) & IDX_MASK;
+        }
+
+        static constexpr size_t slot_align = std::max({Align, alignof(atomic_t), alignof(T)});
+
+        struct alignas (slot_align) Slot
         {
             atomic_t version = ATOMIC_INIT(0);
+            uint32_t seq{0};
+            uint32_t stamp{0};
             T data;
         };
-#ifdef __GNUC__
-#  pragma GCC diagnostic pop
-#endif
 
         std::array<Slot, N> m_slots;
 
-        atomic_t m_latest_idx = ATOMIC_INIT(0);
+        // 最新样本的槽位号与序号，见 pack_latest()
+        atomic_t m_latest = ATOMIC_INIT(0);
 
         atomic_val_t m_next_write_idx{0};
+
+        atomic_t m_generation = ATOMIC_INIT(0);
+
+        // WriterPolicy::Multi 下已领取的发布序号
+        atomic_t m_claim_seq = ATOMIC_INIT(0);
+
+        [[no_unique_address]] mutable BufStats m_stats;
     };
 }
 
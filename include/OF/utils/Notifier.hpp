@@ -0,0 +1,108 @@
+#ifndef OF_NOTIFIER_HPP
+#define OF_NOTIFIER_HPP
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/slist.h>
+
+namespace OF
+{
+    // 一对多唤醒器：发布者调用 notify() 唤醒当前所有挂起的等待者。
+    // notify() 可在 ISR 中调用；没有等待者时只有一次原子读。
+    class Notifier
+    {
+    public:
+        // 等待者节点，由等待线程在自己的栈上持有，生命周期覆盖 attach() 到 detach()
+        struct Waiter
+        {
+            sys_snode_t node{};
+            k_sem* sem{nullptr};
+        };
+
+        Notifier() = default;
+
+        Notifier(const Notifier&) = delete;
+        Notifier& operator=(const Notifier&) = delete;
+
+        void attach(Waiter& waiter) noexcept
+        {
+            const k_spinlock_key_t key = k_spin_lock(&m_lock);
+            sys_slist_append(&m_waiters, &waiter.node);
+            atomic_inc(&m_waiter_cnt);
+            k_spin_unlock(&m_lock, key);
+        }
+
+        void detach(Waiter& waiter) noexcept
+        {
+            const k_spinlock_key_t key = k_spin_lock(&m_lock);
+            if (sys_slist_find_and_remove(&m_waiters, &waiter.node))
+            {
+                atomic_dec(&m_waiter_cnt);
+            }
+            k_spin_unlock(&m_lock, key);
+        }
+
+        /**
+         * @brief pred() 为真时阻塞，直到下一次 notify() 或超时
+         *
+         * pred 读取的状态必须在发布者调用 notify() 之前提交，返回后调用者应重新检查状态。
+         */
+        template <typename Pred>
+        void wait_while(const Pred& pred, k_timeout_t timeout)
+        {
+            if (!pred())
+            {
+                return;
+            }
+
+            k_sem sem;
+            k_sem_init(&sem, 0, 1);
+            Waiter waiter{.sem = &sem};
+
+            attach(waiter);
+            if (pred())
+            {
+                (void)k_sem_take(&sem, timeout);
+            }
+            detach(waiter);
+        }
+
+        void notify() noexcept
+        {
+            // 发布者必须先提交数据/世代号再调用 notify()，等待者先 attach() 再检查世代号，
+            // 两侧都是顺序一致的原子操作，因此不会丢失唤醒。
+            if (atomic_get(&m_waiter_cnt) == 0)
+            {
+                return;
+            }
+
+            // 自旋锁内 k_sem_give() 不会切换线程；线程上下文中额外锁住调度器，
+            // 在 k_sched_unlock() 时立即切换到被唤醒的高优先级线程。ISR 退出时会自行调度。
+            const bool in_isr = k_is_in_isr();
+            if (!in_isr)
+            {
+                k_sched_lock();
+            }
+
+            const k_spinlock_key_t key = k_spin_lock(&m_lock);
+            Waiter* waiter;
+            SYS_SLIST_FOR_EACH_CONTAINER(&m_waiters, waiter, node)
+            {
+                k_sem_give(waiter->sem);
+            }
+            k_spin_unlock(&m_lock, key);
+
+            if (!in_isr)
+            {
+                k_sched_unlock();
+            }
+        }
+
+    private:
+        k_spinlock m_lock{};
+        sys_slist_t m_waiters{};
+        atomic_t m_waiter_cnt = ATOMIC_INIT(0);
+    };
+}
+
+#endif //OF_NOTIFIER_HPP
@@ -0,0 +1,218 @@
+#ifndef OF_QUEUEBUF_HPP
+#define OF_QUEUEBUF_HPP
+
+#include <array>
+#include <type_traits>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/kernel.h>
+
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/SmpFence.hpp>
+#include <OF/utils/NBuf.hpp>
+
+namespace OF
+{
+    // 单写者、多读者的无损环形队列。
+    // 写者从不阻塞；每个读者持有自己的 Cursor，落后超过 N 条时丢弃最旧样本并计数。
+    // 槽位号为 seq % N，N 须为 2 的幂，序号回绕时相邻序号仍落在相邻槽位。
+    template <typename T, size_t N>
+        requires std::is_standard_layout_v<T> && (N >= 2) && ((N & (N - 1)) == 0)
+    class QueueBuf
+    {
+    public:
+        // 读者私有的读取位置
+        struct Cursor
+        {
+            uint32_t next{1}; // 下一条要读取的发布序号
+            uint32_t dropped{0}; // 累计因溢出而丢失的样本数
+        };
+
+        struct PollResult
+        {
+            uint32_t received; // 本次交付的样本数
+            uint32_t dropped; // 本次发现的丢失样本数
+        };
+
+        QueueBuf() = default;
+
+        QueueBuf(const QueueBuf&) = delete;
+        QueueBuf& operator =(const QueueBuf&) = delete;
+        QueueBuf(QueueBuf&& other) = delete;
+        QueueBuf& operator =(QueueBuf&& other) = delete;
+
+        void write(const T& data) noexcept
+        {
+            m_stats.on_write();
+            const auto seq = static_cast<uint32_t>(atomic_get(&m_head)) + 1;
+            auto& slot = m_slots[seq % N];
+
+            atomic_inc(&slot.version);
+            smp_write_fence();
+            slot.data = data;
+            slot.seq = seq;
+            slot.stamp = k_cycle_get_32();
+            smp_write_fence();
+            atomic_inc(&slot.version);
+
+            atomic_set(&m_head, seq);
+        }
+
+        // 写入次数与 latest()/latest_meta() 的读取统计，CONFIG_TOPIC_STATS 关闭时恒为 0
+        [[nodiscard]] BufStatsSnapshot stats() const noexcept
+        {
+            return m_stats.snapshot();
+        }
+
+        void reset_stats() noexcept
+        {
+            m_stats.reset();
+        }
+
+        // 最新一次发布的序号
+        [[nodiscard]] uint32_t head() const noexcept
+        {
+            return static_cast<uint32_t>(atomic_get(&m_head));
+        }
+
+        // 创建一个只接收此后发布样本的读者
+        [[nodiscard]] Cursor subscribe() const noexcept
+        {
+            return Cursor{.next = head() + 1};
+        }
+
+        [[nodiscard]] bool has_new(const Cursor& cursor) const noexcept
+        {
+            return static_cast<int32_t>(head() - cursor.next) >= 0;
+        }
+
+        /**
+         * @brief 按发布顺序把 cursor 之后的所有样本交给 func(const T&)
+         * @param max 本次最多交付的样本数
+         */
+        template <typename Func>
+        PollResult poll(Cursor& cursor, const Func& func, const uint32_t max = UINT32_MAX) const
+        {
+            PollResult result{0, 0};
+            T copy{};
+
+            while (result.received < max)
+            {
+                const auto head_seq = head();
+                if (static_cast<int32_t>(head_seq - cursor.next) < 0)
+                {
+                    break;
+                }
+
+                // 落后超过 N 条：最旧的样本已被覆盖，直接跳到仍在环中的最旧样本
+                if (head_seq - cursor.next >= N)
+                {
+                    const uint32_t lost = head_seq - cursor.next - (N - 1);
+                    result.dropped += lost;
+                    cursor.next += lost;
+                }
+
+                const auto& slot = m_slots[cursor.next % N];
+                const auto v1 = atomic_get(&slot.version);
+                smp_read_fence();
+                copy = slot.data;
+                const uint32_t seq = slot.seq;
+                smp_read_fence();
+                const auto v2 = atomic_get(&slot.version);
+
+                if ((v1 & 1) || v1 != v2 || seq != cursor.next)
+                {
+                    // 槽位正被写者覆盖，或已被序号 +N 的样本替换：此样本丢失
+                    ++result.dropped;
+                    ++cursor.next;
+                    continue;
+                }
+
+                func(copy);
+                ++cursor.next;
+                ++result.received;
+            }
+
+            cursor.dropped += result.dropped;
+            return result;
+        }
+
+        // 读取最新发布的样本，不影响任何 Cursor
+        T latest() const noexcept
+        {
+            T copy{};
+            latest_into(copy);
+            return copy;
+        }
+
+        // 把最新样本写入 out，返回其发布序号
+        uint32_t latest_into(T& out) const noexcept
+        {
+            uint32_t seq{};
+            read_latest([&out, &seq](const Slot& slot)
+            {
+                out = slot.data;
+                seq = slot.seq;
+            });
+            return seq;
+        }
+
+        // 最新样本的序号与时间戳
+        SampleMeta latest_meta() const noexcept
+        {
+            SampleMeta meta{};
+            read_latest([&meta](const Slot& slot)
+            {
+                meta.seq = slot.seq;
+                meta.stamp = slot.stamp;
+            });
+            return meta;
+        }
+
+    private:
+        struct Slot
+        {
+            atomic_t version = ATOMIC_INIT(0);
+            uint32_t seq{0};
+            uint32_t stamp{0};
+            T data;
+        };
+
+        template <typename Func>
+        void read_latest(const Func& func) const
+        {
+            const auto& slot = m_slots[head() % N];
+            const uint32_t start = BufStats::now();
+            uint32_t retries{}, yields{};
+            while (true)
+            {
+                const auto v1 = atomic_get(&slot.version);
+                if (v1 & 1)
+                {
+                    ++yields;
+                    k_yield();
+                    continue;
+                }
+
+                smp_read_fence();
+                func(slot);
+                smp_read_fence();
+
+                if (atomic_get(&slot.version) == v1)
+                {
+                    break;
+                }
+                ++retries;
+            }
+            m_stats.on_read(retries, yields, start);
+        }
+
+        std::array<Slot, N> m_slots;
+
+        atomic_t m_head = ATOMIC_INIT(0);
+
+        [[no_unique_address]] mutable BufStats m_stats;
+    };
+}
+
+#endif //OF_QUEUEBUF_HPP
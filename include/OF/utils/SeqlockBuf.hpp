@@ -6,6 +6,9 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/kernel.h>
 
+#include <OF/utils/BufStats.hpp>
+#include <OF/utils/SmpFence.hpp>
+
 namespace OF
 {
 
@@ -16,13 +19,15 @@ namespace OF
         // no lock
         void write(const T& val)
         {
+            m_stats.on_write();
+
             // 1. version + 1 (odd), writing...
             atomic_inc(&m_version);
 
             // 2. writing data
-            compiler_barrier();
+            smp_write_fence();
             m_data = val;
-            compiler_barrier();
+            smp_write_fence();
 
             // 3. version + 1 (even)，written done.
             atomic_inc(&m_version);
@@ -31,13 +36,15 @@ namespace OF
         template <typename Func>
         void manipulate(Func& func)
         {
+            m_stats.on_write();
+
             // 1. version + 1 (odd), writing...
             atomic_inc(&m_version);
 
             // 2. manipulate data
-            compiler_barrier();
+            smp_write_fence();
             func(m_data);
-            compiler_barrier();
+            smp_write_fence();
 
             // 3. version + 1 (even)，written done.
             atomic_inc(&m_version);
@@ -47,37 +54,55 @@ namespace OF
         T read()
         {
             T val;
-            uint32_t v1, v2{};
-            do
+            const uint32_t start = BufStats::now();
+            uint32_t retries{}, yields{};
+            while (true)
             {
                 // 1. get version
-                v1 = atomic_get(&m_version);
+                const auto v1 = atomic_get(&m_version);
 
                 // odd -> someone's writing, keep waiting...
                 if (v1 & 1)
                 {
+                    ++yields;
                     k_yield();
                     continue;
                 }
 
                 // 2. copy data
-                compiler_barrier();
+                smp_read_fence();
                 val = m_data;
-                compiler_barrier();
+                smp_read_fence();
 
-                // 3. get version again
-                v2 = atomic_get(&m_version);
+                // 3. get version again, unchanged means the copy is consistent
+                if (atomic_get(&m_version) == v1)
+                {
+                    break;
+                }
 
-                // 4. version changed(v1 != v2) means data corrupted, retry.
+                // 4. version changed means data corrupted, retry.
+                ++retries;
             }
-            while (v1 != v2);
+            m_stats.on_read(retries, yields, start);
 
             return val;
         }
 
+        // 读写竞争统计，CONFIG_TOPIC_STATS 关闭时恒为 0
+        [[nodiscard]] BufStatsSnapshot stats() const
+        {
+            return m_stats.snapshot();
+        }
+
+        void reset_stats()
+        {
+            m_stats.reset();
+        }
+
     private:
         T m_data{};
         atomic_t m_version = ATOMIC_INIT(0);
+        [[no_unique_address]] BufStats m_stats;
     };
 };
 
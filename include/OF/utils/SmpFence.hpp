@@ -0,0 +1,37 @@
+#ifndef OF_SMPFENCE_HPP
+#define OF_SMPFENCE_HPP
+
+#include <zephyr/toolchain.h>
+
+#ifdef CONFIG_SMP
+#include <atomic>
+#endif
+
+namespace OF
+{
+    // seqlock 读写两端使用的内存屏障。
+    // 单核上只需阻止编译器重排，与原来的 compiler_barrier() 完全相同；
+    // CONFIG_SMP 下还要阻止其他核心观察到乱序的访存（ARM 上为 dmb，x86 上仍为空）。
+
+    // 读端：版本号的读取与数据拷贝之间，保证先读到的版本号能覆盖拷贝出的数据
+    inline void smp_read_fence() noexcept
+    {
+#ifdef CONFIG_SMP
+        std::atomic_thread_fence(std::memory_order_acquire);
+#else
+        compiler_barrier();
+#endif
+    }
+
+    // 写端：版本号置奇与数据写入之间、数据写入与版本号置偶之间
+    inline void smp_write_fence() noexcept
+    {
+#ifdef CONFIG_SMP
+        std::atomic_thread_fence(std::memory_order_release);
+#else
+        compiler_barrier();
+#endif
+    }
+}
+
+#endif //OF_SMPFENCE_HPP
@@ -11,6 +11,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 
+#include <OF/utils/HistoryBuf.hpp>
 #include <OF/utils/SeqlockBuf.hpp>
 
 #define DT_DRV_COMPAT one_framework_imu_hub
@@ -28,6 +29,10 @@ namespace OF
     OF_CCM_ATTR Mahony g_mahony{1.5f, 0.0f};
     OF_CCM_ATTR IMUData g_imu_data{};
     OF_CCM_ATTR SeqlockBuf<IMUData> g_imu_buf;
+#if !defined(CONFIG_IMU_HUB_RESOLVER_NONE) && CONFIG_IMU_HUB_HISTORY_N > 0
+    // 按发布时刻保存的姿态历史，供自瞄等按图像时间戳回溯
+    OF_CCM_ATTR HistoryBuf<IMUData::Quaternion, CONFIG_IMU_HUB_HISTORY_N> g_attitude_history;
+#endif
     OF_CCM_ATTR uint64_t g_prev_timestamp{};
     RTIO_DEFINE_WITH_MEMPOOL(imu_rtio_ctx, 16, 16, 16, 512, sizeof(void *));
 
@@ -221,6 +226,13 @@ namespace OF
         return g_imu_buf.read();
     }
 
+#if !defined(CONFIG_IMU_HUB_RESOLVER_NONE) && CONFIG_IMU_HUB_HISTORY_N > 0
+    std::optional<IMUData::Quaternion> ImuHub::getAttitudeAt(const uint32_t stamp)
+    {
+        return g_attitude_history.sample_at(stamp);
+    }
+#endif
+
     void ImuHub::process_imu_data(int result, uint8_t* buf, uint32_t buf_len, void* userdata)
     {
         ARG_UNUSED(buf_len);
@@ -394,6 +406,9 @@ namespace OF
         g_mahony.getEulerAngle(p, r, y);
 
         g_imu_buf.write(g_imu_data);
+#if CONFIG_IMU_HUB_HISTORY_N > 0
+        g_attitude_history.push(k_cycle_get_32(), g_imu_data.quat);
+#endif
     }
 
 } // namespace OF
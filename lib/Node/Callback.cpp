@@ -0,0 +1,56 @@
+#include <OF/lib/Node/Callback.hpp>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+extern "C" {
+extern OF::topic_callback _topic_callback_list_start[];
+extern OF::topic_callback _topic_callback_list_end[];
+}
+
+namespace OF
+{
+    LOG_MODULE_DECLARE(NodeSystem, CONFIG_NODE_LOG_LEVEL);
+
+    namespace
+    {
+        K_THREAD_STACK_DEFINE(s_workq_stack, CONFIG_TOPIC_CALLBACK_WORKQ_STACK_SIZE);
+        k_work_q s_workq;
+
+        void deferred_handler(k_work* work)
+        {
+            auto* cb = CONTAINER_OF(work, topic_callback, work);
+            cb->invoke(cb, nullptr);
+        }
+    }
+
+    void submit_topic_callback(topic_callback* cb)
+    {
+        k_work_submit_to_queue(&s_workq, &cb->work);
+    }
+
+    void attach_topic_callbacks()
+    {
+        bool has_deferred = false;
+        for (topic_callback* cb = _topic_callback_list_start; cb < _topic_callback_list_end; ++cb)
+        {
+            // Topic 与类型已由 ONE_TOPIC_CALLBACK 在编译和链接时检查
+            const topic_desc* desc = cb->link.desc;
+            if (cb->mode == CallbackMode::Deferred)
+            {
+                k_work_init(&cb->work, deferred_handler);
+                has_deferred = true;
+            }
+            desc->attach_func(desc, cb);
+            LOG_DBG("Callback %s attached to %s", cb->name, desc->name);
+        }
+
+        // 没有 Deferred 回调时不创建工作队列线程
+        if (has_deferred)
+        {
+            k_work_queue_start(&s_workq, s_workq_stack, K_THREAD_STACK_SIZEOF(s_workq_stack),
+                               CONFIG_TOPIC_CALLBACK_WORKQ_PRIORITY, nullptr);
+            k_thread_name_set(&s_workq.thread, "topic_cb");
+        }
+    }
+}
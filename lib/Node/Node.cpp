@@ -1,13 +1,19 @@
+#include <OF/lib/Node/Callback.hpp>
 #include <OF/lib/Node/Descriptor.hpp>
 #include <OF/lib/Node/Node.hpp>
 #include <OF/lib/Node/NodeManager.hpp>
 #include <OF/lib/Node/Topic.hpp>
 
+#include <cstddef>
+
+#include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 
 extern "C" {
 extern OF::node_desc _node_desc_list_start[];
 extern OF::node_desc _node_desc_list_end[];
+extern OF::topic_desc _topic_desc_list_start[];
+extern OF::topic_desc _topic_desc_list_end[];
 }
 
 namespace OF
@@ -27,4 +33,120 @@ namespace OF
             desc->start_func();
         }
     }
+
+#ifdef CONFIG_TOPIC_GRAPH
+    // 供 topic_graph.py 读取，见 topic_layout
+    __attribute__((__section__(".topic_layout"))) __used const topic_layout g_topic_layout = {
+        .desc_size = sizeof(topic_desc),
+        .desc_name = offsetof(topic_desc, name),
+        .desc_type_size = offsetof(topic_desc, type_size),
+        .desc_footprint = offsetof(topic_desc, footprint),
+        .node_size = sizeof(node_desc),
+        .node_name = offsetof(node_desc, name),
+        .node_publishes = offsetof(node_desc, publishes),
+        .node_subscribes = offsetof(node_desc, subscribes),
+        .node_publish_cnt = offsetof(node_desc, publish_cnt),
+        .node_subscribe_cnt = offsetof(node_desc, subscribe_cnt),
+        .link_size = sizeof(topic_link),
+        .link_desc = offsetof(topic_link, desc),
+        .publisher_size = sizeof(topic_publisher),
+        .publisher_name = offsetof(topic_publisher, name),
+        .publisher_link = offsetof(topic_publisher, link),
+    };
+#endif
+
+    // 链接脚本未按名称排序（或存在重名 Topic）时退化为线性查找
+    static bool s_topics_sorted = true;
+
+    std::span<topic_desc> all_topics()
+    {
+        return {_topic_desc_list_start, _topic_desc_list_end};
+    }
+
+    topic_desc* find_topic(const std::string_view name)
+    {
+        const auto topics = all_topics();
+        if (!s_topics_sorted)
+        {
+            for (auto& desc : topics)
+            {
+                if (name == desc.name)
+                {
+                    return &desc;
+                }
+            }
+            return nullptr;
+        }
+
+        size_t lo = 0;
+        size_t hi = topics.size();
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            const int cmp = name.compare(topics[mid].name);
+            if (cmp == 0)
+            {
+                return &topics[mid];
+            }
+            if (cmp < 0)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t check_topic_qos(const topic_qos_cb_t cb, void* user_data)
+    {
+        size_t missed = 0;
+        for (const auto& desc : all_topics())
+        {
+            if (desc.status_func == nullptr)
+            {
+                continue;
+            }
+            const TopicStatus status = desc.status_func(&desc, nullptr);
+            if (status == TopicStatus::Fresh)
+            {
+                continue;
+            }
+            ++missed;
+            if (cb != nullptr)
+            {
+                cb(desc, status, user_data);
+            }
+        }
+        return missed;
+    }
+
+    static int check_topic_table()
+    {
+        const auto topics = all_topics();
+        for (size_t i = 1; i < topics.size(); ++i)
+        {
+            const int cmp = std::string_view(topics[i - 1].name).compare(topics[i].name);
+            if (cmp == 0)
+            {
+                LOG_ERR("Duplicate topic name: %s", topics[i].name);
+                s_topics_sorted = false;
+            }
+            else if (cmp > 0)
+            {
+                LOG_WRN("Topic table is not sorted by name, find_topic() falls back to linear search");
+                s_topics_sorted = false;
+            }
+        }
+        LOG_DBG("%u topics registered", static_cast<uint32_t>(topics.size()));
+#ifdef CONFIG_TOPIC_CALLBACKS
+        // 按名称查找 Topic，需在上面确定查找方式之后进行
+        attach_topic_callbacks();
+#endif
+        return 0;
+    }
+
+    SYS_INIT(check_topic_table, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 }
@@ -0,0 +1,172 @@
+#include <OF/lib/Node/NodeManager.hpp>
+#include <OF/lib/Node/Recorder.hpp>
+
+#include <cstring>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+namespace OF
+{
+    LOG_MODULE_DECLARE(NodeSystem, CONFIG_NODE_LOG_LEVEL);
+
+    namespace
+    {
+        constexpr size_t RING_SIZE = CONFIG_NODE_RECORDER_BUF_SIZE;
+
+        // 记录首尾相接地存放，跨越环尾的记录被拆成两段
+        uint8_t s_ring[RING_SIZE];
+        size_t s_head; // 下一条记录的写入位置
+        size_t s_tail; // 最旧一条记录的位置
+        size_t s_used;
+        uint32_t s_records;
+        uint32_t s_overwritten;
+        atomic_t s_running = ATOMIC_INIT(0);
+        k_spinlock s_lock;
+
+        void ring_write(const size_t offset, const void* src, const size_t len)
+        {
+            const size_t first = MIN(len, RING_SIZE - offset);
+            std::memcpy(&s_ring[offset], src, first);
+            std::memcpy(s_ring, static_cast<const uint8_t*>(src) + first, len - first);
+        }
+
+        void ring_read(const size_t offset, void* dst, const size_t len)
+        {
+            const size_t first = MIN(len, RING_SIZE - offset);
+            std::memcpy(dst, &s_ring[offset], first);
+            std::memcpy(static_cast<uint8_t*>(dst) + first, s_ring, len - first);
+        }
+    }
+
+    void record_sample(const topic_desc* desc, const void* data, const size_t size)
+    {
+        if (!atomic_get(&s_running))
+        {
+            return;
+        }
+        const size_t total = sizeof(RecordHeader) + size;
+        if (total > RING_SIZE)
+        {
+            return;
+        }
+
+        const RecordHeader header{
+            .topic = static_cast<uint16_t>(desc - all_topics().data()),
+            .size = static_cast<uint16_t>(size),
+            .stamp = k_cycle_get_32(),
+        };
+
+        const k_spinlock_key_t key = k_spin_lock(&s_lock);
+        // 加锁后再检查一次，recorder_stop() 之后拿到锁的一方不会再改动环
+        if (!atomic_get(&s_running))
+        {
+            k_spin_unlock(&s_lock, key);
+            return;
+        }
+        // 空间不足时丢弃最旧的记录
+        while (RING_SIZE - s_used < total)
+        {
+            RecordHeader oldest;
+            ring_read(s_tail, &oldest, sizeof(oldest));
+            const size_t len = sizeof(oldest) + oldest.size;
+            s_tail = (s_tail + len) % RING_SIZE;
+            s_used -= len;
+            --s_records;
+            ++s_overwritten;
+        }
+        ring_write(s_head, &header, sizeof(header));
+        ring_write((s_head + sizeof(header)) % RING_SIZE, data, size);
+        s_head = (s_head + total) % RING_SIZE;
+        s_used += total;
+        ++s_records;
+        k_spin_unlock(&s_lock, key);
+    }
+
+    int recorder_select(const topic_desc& desc, const bool enable)
+    {
+        if (desc.record_func == nullptr || desc.type_size > UINT16_MAX)
+        {
+            return -ENOTSUP;
+        }
+        desc.record_func(&desc, enable);
+        return 0;
+    }
+
+    void recorder_start()
+    {
+        atomic_set(&s_running, 1);
+    }
+
+    void recorder_stop()
+    {
+        atomic_clear(&s_running);
+    }
+
+    void recorder_clear()
+    {
+        const k_spinlock_key_t key = k_spin_lock(&s_lock);
+        s_head = 0;
+        s_tail = 0;
+        s_used = 0;
+        s_records = 0;
+        s_overwritten = 0;
+        k_spin_unlock(&s_lock, key);
+    }
+
+    RecorderStatus recorder_status()
+    {
+        const k_spinlock_key_t key = k_spin_lock(&s_lock);
+        const RecorderStatus status{
+            .running = atomic_get(&s_running) != 0,
+            .records = s_records,
+            .bytes = static_cast<uint32_t>(s_used),
+            .overwritten = s_overwritten,
+        };
+        k_spin_unlock(&s_lock, key);
+        return status;
+    }
+
+    int recorder_dump(const record_sink_t sink, void* user_data)
+    {
+        if (atomic_get(&s_running))
+        {
+            return -EBUSY;
+        }
+
+        // 等待停止前已进入 record_sample() 的写者完成
+        const k_spinlock_key_t key = k_spin_lock(&s_lock);
+        const size_t tail = s_tail;
+        const size_t used = s_used;
+        k_spin_unlock(&s_lock, key);
+
+        const auto topics = all_topics();
+        const RecordFileHeader header{
+            .magic = RECORD_FILE_MAGIC,
+            .cycles_per_sec = static_cast<uint32_t>(sys_clock_hw_cycles_per_sec()),
+            .topic_cnt = static_cast<uint16_t>(topics.size()),
+            .reserved = 0,
+            .record_bytes = static_cast<uint32_t>(used),
+        };
+        sink(reinterpret_cast<const uint8_t*>(&header), sizeof(header), user_data);
+
+        for (const auto& desc : topics)
+        {
+            const auto type_size = static_cast<uint16_t>(desc.type_size);
+            const auto name_len = static_cast<uint8_t>(MIN(strlen(desc.name), UINT8_MAX));
+            sink(reinterpret_cast<const uint8_t*>(&type_size), sizeof(type_size), user_data);
+            sink(&name_len, sizeof(name_len), user_data);
+            sink(reinterpret_cast<const uint8_t*>(desc.name), name_len, user_data);
+        }
+
+        // 录制已停止，环的内容不会再变化
+        const size_t first = MIN(used, RING_SIZE - tail);
+        sink(&s_ring[tail], first, user_data);
+        if (used > first)
+        {
+            sink(s_ring, used - first, user_data);
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,177 @@
+#include <OF/lib/Node/NodeManager.hpp>
+#include <OF/lib/Node/Recorder.hpp>
+
+#include <cstring>
+#include <string_view>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+namespace OF
+{
+    LOG_MODULE_DECLARE(NodeSystem, CONFIG_NODE_LOG_LEVEL);
+
+    namespace
+    {
+        // 按字节读取导出文件，越界时置 ok = false
+        class DumpReader
+        {
+        public:
+            explicit DumpReader(const std::span<const uint8_t> data) :
+                m_data(data)
+            {
+            }
+
+            template <typename T>
+            T read()
+            {
+                T val{};
+                const auto bytes = take(sizeof(T));
+                if (!bytes.empty())
+                {
+                    std::memcpy(&val, bytes.data(), sizeof(T));
+                }
+                return val;
+            }
+
+            std::span<const uint8_t> take(const size_t len)
+            {
+                if (m_data.size() - m_pos < len)
+                {
+                    ok = false;
+                    return {};
+                }
+                const auto bytes = m_data.subspan(m_pos, len);
+                m_pos += len;
+                return bytes;
+            }
+
+            [[nodiscard]] bool empty() const
+            {
+                return m_pos == m_data.size();
+            }
+
+            bool ok{true};
+
+        private:
+            std::span<const uint8_t> m_data;
+            size_t m_pos{0};
+        };
+    }
+
+    int recorder_replay(const std::span<const uint8_t> dump, const ReplaySpeed speed)
+    {
+        DumpReader reader(dump);
+        const auto header = reader.read<RecordFileHeader>();
+        if (!reader.ok || header.magic != RECORD_FILE_MAGIC || header.cycles_per_sec == 0)
+        {
+            LOG_ERR("Replay: not a topic record file");
+            return -EINVAL;
+        }
+        if (header.topic_cnt > CONFIG_NODE_REPLAY_MAX_TOPICS)
+        {
+            LOG_ERR("Replay: %u topics in file, CONFIG_NODE_REPLAY_MAX_TOPICS is %u", header.topic_cnt,
+                    CONFIG_NODE_REPLAY_MAX_TOPICS);
+            return -ENOMEM;
+        }
+
+        // 文件中的 Topic 序号 -> 当前固件中同名且大小一致的 Topic
+        const topic_desc* targets[CONFIG_NODE_REPLAY_MAX_TOPICS]{};
+        for (uint16_t id = 0; id < header.topic_cnt; ++id)
+        {
+            const auto type_size = reader.read<uint16_t>();
+            const auto name_len = reader.read<uint8_t>();
+            const auto name = reader.take(name_len);
+            if (!reader.ok)
+            {
+                return -EINVAL;
+            }
+
+            const std::string_view name_sv(reinterpret_cast<const char*>(name.data()), name.size());
+            const topic_desc* desc = find_topic(name_sv);
+            if (desc == nullptr || desc->write_func == nullptr)
+            {
+                LOG_WRN("Replay: topic '%.*s' not found, skipped", name_len, name.data());
+            }
+            else if (desc->type_size != type_size)
+            {
+                LOG_WRN("Replay: topic '%s' size mismatch (%u in file, %u in firmware), skipped", desc->name,
+                        type_size, desc->type_size);
+            }
+            else
+            {
+                targets[id] = desc;
+            }
+        }
+
+        DumpReader records(reader.take(header.record_bytes));
+        if (!reader.ok)
+        {
+            return -EINVAL;
+        }
+
+        int replayed = 0;
+        bool first = true;
+        uint32_t prev_stamp{};
+        uint64_t elapsed_cyc{};
+        const int64_t start_ticks = k_uptime_ticks();
+        while (!records.empty())
+        {
+            const auto record = records.read<RecordHeader>();
+            const auto payload = records.take(record.size);
+            if (!records.ok)
+            {
+                LOG_ERR("Replay: truncated record");
+                return -EINVAL;
+            }
+
+            // 相邻记录的间隔按 32 位周期差累加，可跨越计数器回绕
+            elapsed_cyc += first ? 0 : static_cast<uint32_t>(record.stamp - prev_stamp);
+            prev_stamp = record.stamp;
+            first = false;
+
+            if (speed == ReplaySpeed::RealTime)
+            {
+                const int64_t due_us = static_cast<int64_t>(elapsed_cyc * 1000000U / header.cycles_per_sec);
+                const int64_t now_us = static_cast<int64_t>(k_ticks_to_us_floor64(k_uptime_ticks() - start_ticks));
+                if (due_us > now_us)
+                {
+                    k_usleep(static_cast<int32_t>(MIN(due_us - now_us, INT32_MAX)));
+                }
+            }
+
+            const topic_desc* desc = record.topic < header.topic_cnt ? targets[record.topic] : nullptr;
+            if (desc != nullptr)
+            {
+                desc->write_func(desc, payload.data());
+                ++replayed;
+            }
+        }
+        return replayed;
+    }
+
+#ifdef OF_NODE_REPLAY_EMBEDDED
+    namespace
+    {
+        // 由 lib/Node/CMakeLists.txt 根据 CONFIG_NODE_REPLAY_FILE 生成
+        const uint8_t s_replay_file[] = {
+#include "node_replay.inc"
+        };
+
+        void replay_entry(void*, void*, void*)
+        {
+            const auto speed = IS_ENABLED(CONFIG_NODE_REPLAY_REALTIME)
+                                   ? ReplaySpeed::RealTime
+                                   : ReplaySpeed::AsFastAsPossible;
+            const int64_t start = k_uptime_get();
+            const int ret = recorder_replay(s_replay_file, speed);
+            LOG_INF("Replay: %d records in %lld ms", ret, k_uptime_get() - start);
+        }
+    }
+
+    // 延迟启动，等待 main() 中的 start_all_nodes() 创建好各个 Node
+    K_THREAD_DEFINE(node_replay, CONFIG_NODE_REPLAY_STACK_SIZE, replay_entry, nullptr, nullptr, nullptr,
+                    K_LOWEST_APPLICATION_THREAD_PRIO, 0, CONFIG_NODE_REPLAY_DELAY_MS);
+#endif
+}
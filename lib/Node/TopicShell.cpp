@@ -0,0 +1,431 @@
+#include <OF/lib/Node/Descriptor.hpp>
+#include <OF/lib/Node/NodeManager.hpp>
+#include <OF/lib/Node/Qos.hpp>
+#include <OF/lib/Node/Recorder.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+
+using namespace OF;
+
+namespace
+{
+    constexpr uint32_t POLL_PERIOD_MS = 1;
+    constexpr uint32_t DEFAULT_WINDOW_MS = 1000;
+    constexpr uint32_t MAX_WINDOW_MS = 10000;
+    constexpr uint32_t DEFAULT_ECHO_IDLE_MS = 3000;
+    constexpr uint32_t MAX_ECHO_IDLE_MS = 60000;
+
+    // 通过轮询 topic_desc::meta_func 统计得到的发布情况，不在写路径上加任何钩子
+    struct PublishStats
+    {
+        uint32_t msgs; // 窗口内的发布次数（按序号差计算，不会漏计）
+        uint32_t elapsed_ms;
+        uint32_t intervals; // 观测到的相邻两次发布的间隔个数
+        uint32_t min_period_cyc;
+        uint32_t max_period_cyc;
+        uint64_t sum_period_cyc;
+    };
+
+    topic_desc* lookup(const shell* sh, const char* name)
+    {
+        topic_desc* desc = find_topic(name);
+        if (desc == nullptr)
+        {
+            shell_error(sh, "Topic '%s' not found", name);
+        }
+        return desc;
+    }
+
+    uint32_t parse_u32(const char* str, const uint32_t fallback, const uint32_t max)
+    {
+        char* end;
+        const unsigned long val = strtoul(str, &end, 10);
+        if (end == str || *end != '\0' || val == 0)
+        {
+            return fallback;
+        }
+        return val > max ? max : static_cast<uint32_t>(val);
+    }
+
+    PublishStats measure(const topic_desc* desc, const uint32_t window_ms)
+    {
+        PublishStats stats{0, 0, 0, UINT32_MAX, 0, 0};
+        const topic_meta first = desc->meta_func(desc);
+        topic_meta prev = first;
+        const int64_t start = k_uptime_get();
+
+        while (k_uptime_get() - start < window_ms)
+        {
+            k_msleep(POLL_PERIOD_MS);
+            const topic_meta cur = desc->meta_func(desc);
+            if (cur.seq == prev.seq)
+            {
+                continue;
+            }
+            // 两次轮询之间只发布了一次时，时间戳之差就是真实发布周期
+            if (prev.seq != 0 && cur.seq - prev.seq == 1)
+            {
+                const uint32_t period = cur.stamp - prev.stamp;
+                stats.min_period_cyc = MIN(stats.min_period_cyc, period);
+                stats.max_period_cyc = MAX(stats.max_period_cyc, period);
+                stats.sum_period_cyc += period;
+                ++stats.intervals;
+            }
+            prev = cur;
+        }
+
+        stats.elapsed_ms = static_cast<uint32_t>(k_uptime_get() - start);
+        stats.msgs = prev.seq - first.seq;
+        return stats;
+    }
+
+    // 以 0.01 为单位返回每秒的数量
+    uint64_t per_sec_x100(const uint64_t count, const uint32_t elapsed_ms)
+    {
+        return elapsed_ms == 0 ? 0 : count * 100000U / elapsed_ms;
+    }
+
+    int cmd_topic_list(const shell* sh, size_t argc, char** argv)
+    {
+        ARG_UNUSED(argc);
+        ARG_UNUSED(argv);
+
+        uint32_t total = 0;
+        shell_print(sh, "%-24s %8s %10s %-8s %10s", "Name", "Size", "Footprint", "Writer", "Seq");
+        for (const auto& desc : all_topics())
+        {
+            const topic_meta meta = desc.meta_func(&desc);
+            shell_print(sh, "%-24s %8u %10u %-8s %10u", desc.name, desc.type_size, desc.footprint,
+                        desc.multi_writer ? "multi" : "single", meta.seq);
+            total += desc.footprint;
+        }
+        shell_print(sh, "%zu topics, %u bytes", all_topics().size(), total);
+        return 0;
+    }
+
+    int cmd_topic_echo(const shell* sh, size_t argc, char** argv)
+    {
+        const topic_desc* desc = lookup(sh, argv[1]);
+        if (desc == nullptr)
+        {
+            return -ENOENT;
+        }
+        const uint32_t rate_hz = argc > 2 ? parse_u32(argv[2], 10, 1000) : 10;
+        const uint32_t count = argc > 3 ? parse_u32(argv[3], 10, UINT32_MAX) : 10;
+        const uint32_t idle_ms = argc > 4 ? parse_u32(argv[4], DEFAULT_ECHO_IDLE_MS, MAX_ECHO_IDLE_MS)
+                                          : DEFAULT_ECHO_IDLE_MS;
+
+        // 命令在 shell 线程中执行，连续 idle_ms 没有新样本时退出，避免空闲或从未发布的 Topic 卡住 shell
+        uint32_t last_seq = 0;
+        int64_t last_new = k_uptime_get();
+        for (uint32_t printed = 0; printed < count;)
+        {
+            if (desc->meta_func(desc).seq != last_seq)
+            {
+                char buf[CONFIG_TOPIC_FORMAT_BUF_SIZE];
+                FormatSink sink(buf);
+                last_seq = desc->format_func(desc, sink);
+                shell_fprintf(sh, SHELL_NORMAL, "[%u] %s | Size: %u | %s%s\n", last_seq, desc->name,
+                              desc->type_size, sink.c_str(), sink.truncated() ? "..." : "");
+                last_new = k_uptime_get();
+                ++printed;
+            }
+            else if (k_uptime_get() - last_new >= idle_ms)
+            {
+                shell_warn(sh, "No new sample on '%s' in %u ms", desc->name, idle_ms);
+                return -ETIMEDOUT;
+            }
+            k_msleep(1000 / rate_hz);
+        }
+        return 0;
+    }
+
+    int cmd_topic_hz(const shell* sh, size_t argc, char** argv)
+    {
+        const topic_desc* desc = lookup(sh, argv[1]);
+        if (desc == nullptr)
+        {
+            return -ENOENT;
+        }
+        const uint32_t window_ms = argc > 2 ? parse_u32(argv[2], DEFAULT_WINDOW_MS, MAX_WINDOW_MS)
+                                            : DEFAULT_WINDOW_MS;
+
+        const PublishStats stats = measure(desc, window_ms);
+        const uint64_t rate = per_sec_x100(stats.msgs, stats.elapsed_ms);
+        shell_print(sh, "%s: %u msgs in %u ms, rate %u.%02u Hz", desc->name, stats.msgs, stats.elapsed_ms,
+                    static_cast<uint32_t>(rate / 100), static_cast<uint32_t>(rate % 100));
+
+        if (stats.intervals == 0)
+        {
+            shell_print(sh, "  period: n/a (publish rate too high or too low for %u ms polling)",
+                        POLL_PERIOD_MS);
+            return 0;
+        }
+        const uint32_t min_us = k_cyc_to_us_floor32(stats.min_period_cyc);
+        const uint32_t max_us = k_cyc_to_us_floor32(stats.max_period_cyc);
+        const uint32_t avg_us = k_cyc_to_us_floor32(
+            static_cast<uint32_t>(stats.sum_period_cyc / stats.intervals));
+        shell_print(sh, "  period min/avg/max: %u/%u/%u us, jitter: %u us (%u samples)", min_us, avg_us,
+                    max_us, max_us - min_us, stats.intervals);
+        return 0;
+    }
+
+    int cmd_topic_bw(const shell* sh, size_t argc, char** argv)
+    {
+        const topic_desc* desc = lookup(sh, argv[1]);
+        if (desc == nullptr)
+        {
+            return -ENOENT;
+        }
+        const uint32_t window_ms = argc > 2 ? parse_u32(argv[2], DEFAULT_WINDOW_MS, MAX_WINDOW_MS)
+                                            : DEFAULT_WINDOW_MS;
+
+        const PublishStats stats = measure(desc, window_ms);
+        const uint64_t bytes = static_cast<uint64_t>(stats.msgs) * desc->type_size;
+        const uint64_t bw = per_sec_x100(bytes, stats.elapsed_ms);
+        shell_print(sh, "%s: %u msgs x %u B in %u ms, %u.%02u B/s", desc->name, stats.msgs, desc->type_size,
+                    stats.elapsed_ms, static_cast<uint32_t>(bw / 100), static_cast<uint32_t>(bw % 100));
+        return 0;
+    }
+
+    void print_stats(const shell* sh, const topic_desc& desc, const bool reset)
+    {
+        const BufStatsSnapshot s = desc.stats_func(&desc, reset);
+        shell_print(sh, "%-24s %10u %10u %8u %8u %10u", desc.name, s.writes, s.reads, s.retries, s.yields,
+                    k_cyc_to_us_ceil32(s.max_read_cyc));
+    }
+
+    // stats [name] [reset]：省略名称时列出全部 Topic
+    int cmd_topic_stats(const shell* sh, size_t argc, char** argv)
+    {
+        if (!BufStats::enabled)
+        {
+            shell_warn(sh, "CONFIG_TOPIC_STATS is disabled, all counters read 0");
+        }
+
+        const char* name = nullptr;
+        bool reset = false;
+        for (size_t i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "reset") == 0)
+            {
+                reset = true;
+            }
+            else
+            {
+                name = argv[i];
+            }
+        }
+
+        shell_print(sh, "%-24s %10s %10s %8s %8s %10s", "Name", "Writes", "Reads", "Retries", "Yields",
+                    "MaxRd(us)");
+        if (name != nullptr)
+        {
+            const topic_desc* desc = lookup(sh, name);
+            if (desc == nullptr)
+            {
+                return -ENOENT;
+            }
+            print_stats(sh, *desc, reset);
+            return 0;
+        }
+        for (const auto& desc : all_topics())
+        {
+            print_stats(sh, desc, reset);
+        }
+        return 0;
+    }
+
+    void print_qos(const shell* sh, const topic_desc& desc)
+    {
+        // 年龄取自 QoS 监视器记录的 tick，与判断状态的依据一致；Sample::stamp 是会快速回绕的周期计数
+        uint32_t age_ms{};
+        const TopicStatus status = desc.status_func(&desc, &age_ms);
+        shell_print(sh, "%-24s %10u %10u %10u  %s", desc.name, desc.deadline_ms, desc.liveliness_ms, age_ms,
+                    topic_status_str(status));
+    }
+
+    // qos [all]：默认只列出未按期发布的 Topic
+    int cmd_topic_qos(const shell* sh, size_t argc, char** argv)
+    {
+        const bool all = argc > 1 && strcmp(argv[1], "all") == 0;
+
+        shell_print(sh, "%-24s %10s %10s %10s  %s", "Name", "Deadline", "Liveness", "Age(ms)", "Status");
+        size_t declared = 0;
+        for (const auto& desc : all_topics())
+        {
+            if (desc.status_func == nullptr)
+            {
+                continue;
+            }
+            ++declared;
+            if (all || desc.status_func(&desc, nullptr) != TopicStatus::Fresh)
+            {
+                print_qos(sh, desc);
+            }
+        }
+        shell_print(sh, "%zu of %zu topics with QoS missed their deadline", check_topic_qos(), declared);
+        return 0;
+    }
+
+#ifdef CONFIG_NODE_RECORDER
+    constexpr size_t DUMP_LINE_BYTES = 32;
+
+    // 导出内容按十六进制逐行打印，scripts/topic_record.py 可从串口日志中还原出二进制文件
+    struct DumpPrinter
+    {
+        const shell* sh;
+        uint8_t line[DUMP_LINE_BYTES];
+        size_t len;
+
+        void flush()
+        {
+            char hex[DUMP_LINE_BYTES * 2 + 1];
+            for (size_t i = 0; i < len; ++i)
+            {
+                snprintk(&hex[i * 2], 3, "%02x", line[i]);
+            }
+            hex[len * 2] = '\0';
+            shell_print(sh, "OFREC:%s", hex);
+            len = 0;
+        }
+    };
+
+    void dump_sink(const uint8_t* data, const size_t len, void* user_data)
+    {
+        auto* printer = static_cast<DumpPrinter*>(user_data);
+        for (size_t i = 0; i < len; ++i)
+        {
+            printer->line[printer->len++] = data[i];
+            if (printer->len == DUMP_LINE_BYTES)
+            {
+                printer->flush();
+            }
+        }
+    }
+
+    // record start [name...]：省略名称时录制全部 Topic
+    int cmd_record_start(const shell* sh, size_t argc, char** argv)
+    {
+        recorder_stop();
+        for (const auto& desc : all_topics())
+        {
+            recorder_select(desc, argc == 1);
+        }
+        for (size_t i = 1; i < argc; ++i)
+        {
+            const topic_desc* desc = lookup(sh, argv[i]);
+            if (desc == nullptr)
+            {
+                return -ENOENT;
+            }
+            if (recorder_select(*desc, true) != 0)
+            {
+                shell_error(sh, "Topic '%s' cannot be recorded", desc->name);
+                return -ENOTSUP;
+            }
+        }
+        recorder_clear();
+        recorder_start();
+        shell_print(sh, "Recording %s", argc == 1 ? "all topics" : "selected topics");
+        return 0;
+    }
+
+    int cmd_record_stop(const shell* sh, size_t argc, char** argv)
+    {
+        ARG_UNUSED(argc);
+        ARG_UNUSED(argv);
+
+        recorder_stop();
+        const RecorderStatus status = recorder_status();
+        shell_print(sh, "Stopped, %u records (%u bytes), %u overwritten", status.records, status.bytes,
+                    status.overwritten);
+        return 0;
+    }
+
+    int cmd_record_status(const shell* sh, size_t argc, char** argv)
+    {
+        ARG_UNUSED(argc);
+        ARG_UNUSED(argv);
+
+        const RecorderStatus status = recorder_status();
+        shell_print(sh, "%s, %u records (%u/%u bytes), %u overwritten", status.running ? "Recording" : "Stopped",
+                    status.records, status.bytes, CONFIG_NODE_RECORDER_BUF_SIZE, status.overwritten);
+        return 0;
+    }
+
+    int cmd_record_dump(const shell* sh, size_t argc, char** argv)
+    {
+        ARG_UNUSED(argc);
+        ARG_UNUSED(argv);
+
+        recorder_stop();
+        DumpPrinter printer{.sh = sh, .line = {}, .len = 0};
+        const int ret = recorder_dump(dump_sink, &printer);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        if (printer.len != 0)
+        {
+            printer.flush();
+        }
+        shell_print(sh, "OFREC:END");
+        return 0;
+    }
+#endif
+
+    // Tab 补全 Topic 名称
+    void topic_name_get(size_t idx, shell_static_entry* entry)
+    {
+        const auto topics = all_topics();
+        entry->syntax = idx < topics.size() ? topics[idx].name : nullptr;
+        entry->handler = nullptr;
+        entry->help = nullptr;
+        entry->subcmd = nullptr;
+    }
+}
+
+SHELL_DYNAMIC_CMD_CREATE(dsub_topic_name, topic_name_get);
+
+#ifdef CONFIG_NODE_RECORDER
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_topic_record,
+                               SHELL_CMD_ARG(start, &dsub_topic_name,
+                                             "Clear the ring and record: start [name...] (default: all)",
+                                             cmd_record_start, 1, 32),
+                               SHELL_CMD_ARG(stop, nullptr, "Stop recording", cmd_record_stop, 1, 0),
+                               SHELL_CMD_ARG(status, nullptr, "Show recorder status", cmd_record_status, 1, 0),
+                               SHELL_CMD_ARG(dump, nullptr, "Stop and dump the ring as hex lines",
+                                             cmd_record_dump, 1, 0),
+                               SHELL_SUBCMD_SET_END
+);
+#endif
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_topic,
+                               SHELL_CMD_ARG(list, nullptr, "List registered topics", cmd_topic_list, 1, 0),
+                               SHELL_CMD_ARG(echo, &dsub_topic_name,
+                                             "Print new samples: echo <name> [rate_hz] [count] [idle_ms]",
+                                             cmd_topic_echo, 2, 3),
+                               SHELL_CMD_ARG(hz, &dsub_topic_name,
+                                             "Measure publish rate and jitter: hz <name> [window_ms]",
+                                             cmd_topic_hz, 2, 1),
+                               SHELL_CMD_ARG(bw, &dsub_topic_name,
+                                             "Measure publish bandwidth: bw <name> [window_ms]",
+                                             cmd_topic_bw, 2, 1),
+                               SHELL_CMD_ARG(stats, &dsub_topic_name,
+                                             "Show read/write contention counters: stats [name] [reset]",
+                                             cmd_topic_stats, 1, 2),
+                               SHELL_CMD_ARG(qos, nullptr,
+                                             "Show topics that missed their deadline: qos [all]",
+                                             cmd_topic_qos, 1, 1),
+                               SHELL_COND_CMD(CONFIG_NODE_RECORDER, record, &sub_topic_record,
+                                              "Record topic publications", nullptr),
+                               SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(topic, &sub_topic, "Topic inspection commands", nullptr);
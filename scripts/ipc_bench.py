@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+整理与比较 tests/utils/IpcBench 的输出。
+
+    ipc_bench.py extract <运行日志>
+        从运行日志中提取 CSV 表（ipc_bench, 开头的行），保存为基线
+    ipc_bench.py compare <基线> <运行日志> [--tolerance 0.2]
+        逐项比较中位数与 p99，任一项比基线慢超过容差时返回 1；最大值受抢占影响较大，只显示不判定
+"""
+
+import argparse
+import csv
+import sys
+from pathlib import Path
+
+PREFIX = 'ipc_bench,'
+KEY = ('primitive', 'depth', 'bytes', 'readers', 'op')
+CHECKED = ('median', 'p99')
+
+
+def read_rows(path: str) -> tuple[str | None, list[dict]]:
+    """返回 (计时时钟频率, 结果行)，忽略日志中的其他输出"""
+    clock, lines = None, []
+    for line in Path(path).read_text(errors='replace').splitlines():
+        line = line.strip()
+        if line.startswith('ipc_bench_clock,'):
+            clock = line.split(',', 1)[1]
+        elif line.startswith(PREFIX):
+            lines.append(line[len(PREFIX):])
+    if not lines:
+        sys.exit(f'ipc_bench: no results in {path}')
+    return clock, list(csv.DictReader(lines))
+
+
+def cmd_extract(args):
+    clock, rows = read_rows(args.log)
+    print(f'ipc_bench_clock,{clock}')
+    print(PREFIX + ','.join(rows[0].keys()))
+    for row in rows:
+        print(PREFIX + ','.join(row.values()))
+
+
+def cmd_compare(args):
+    base_clock, base_rows = read_rows(args.baseline)
+    clock, rows = read_rows(args.current)
+    if base_clock != clock:
+        sys.exit(f'ipc_bench: clock differs ({base_clock} vs {clock}), results are from different platforms')
+
+    baseline = {tuple(row[k] for k in KEY): row for row in base_rows}
+    regressions = 0
+    print(f"{'primitive':<8} {'N':>2} {'bytes':>5} {'rd':>2} {'op':<5} "
+          f"{'median':>17} {'p99':>17} {'max':>17}")
+    for row in rows:
+        key = tuple(row[k] for k in KEY)
+        base = baseline.get(key)
+        if base is None:
+            continue
+        cells, bad = [], False
+        for col in CHECKED + ('max',):
+            old, new = float(base[col]), float(row[col])
+            ratio = new / old - 1 if old > 0 else 0.0
+            mark = ''
+            if col in CHECKED and ratio > args.tolerance:
+                mark, bad = '!', True
+            cells.append(f'{new:>8.2f} {ratio:>+6.0%}{mark:1}')
+        regressions += bad
+        print(f'{key[0]:<8} {key[1]:>2} {key[2]:>5} {key[3]:>2} {key[4]:<5} ' + ' '.join(cells))
+
+    if regressions:
+        print(f'ipc_bench: {regressions} case(s) slower than baseline by more than {args.tolerance:.0%}',
+              file=sys.stderr)
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Extract and compare IPC benchmark results')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    extract = sub.add_parser('extract', help='print the CSV table from a run log')
+    extract.add_argument('log', help='console output of tests/utils/IpcBench')
+    extract.set_defaults(func=cmd_extract)
+
+    compare = sub.add_parser('compare', help='compare a run against a baseline')
+    compare.add_argument('baseline', help='baseline CSV or run log')
+    compare.add_argument('current', help='CSV or run log to check')
+    compare.add_argument('--tolerance', type=float, default=0.2, help='allowed slowdown, default 0.2 (20%%)')
+    compare.set_defaults(func=cmd_compare)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+构建后统计每个 Topic 实例占用的内存及所在区域。
+
+由 lib/Node/CMakeLists.txt 在 CONFIG_TOPIC_FOOTPRINT_REPORT 开启时作为 post-build 命令调用：
+    topic_footprint.py zephyr.elf
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+INSTANCE_RE = re.compile(r'_topic_instance_(\w+)$')
+DESC_RE = re.compile(r'_topic_desc_(\w+)$')
+SHF_ALLOC = 0x2
+
+
+def plain_name(sym_name: str) -> str:
+    """命名空间内注册的 Topic 符号经过 C++ 修饰（_ZN...E），去掉结尾的 E"""
+    return sym_name[:-1] if sym_name.startswith('_ZN') else sym_name
+
+
+def region_of(section_name: str) -> str:
+    """根据输出段名判断内存区域，对应 ONE_TOPIC_REGISTER_IN 的 FAST/DMA/NOCACHE 及板级自定义段"""
+    if 'dtcm' in section_name:
+        return 'DTCM'
+    if 'ccm' in section_name:
+        return 'CCM'
+    if 'nocache' in section_name:
+        return 'NOCACHE'
+    if section_name in ('datas', 'bss', 'noinit') or section_name.startswith(('.data', '.bss', '.noinit')):
+        return 'RAM'
+    # OF_DMA_ATTR 等指定的其他段（如 zephyr,memory-region 生成的 SRAM1）直接使用段名
+    return section_name.lstrip('.')
+
+
+def loaded(section) -> bool:
+    """段内容是否在镜像中占有地址：跳过 .bss 等 NOBITS 段与 .topic_check 等不分配内存的信息段"""
+    return section['sh_type'] != 'SHT_NOBITS' and bool(section['sh_flags'] & SHF_ALLOC)
+
+
+def read_cstring(elf: ELFFile, addr: int) -> str | None:
+    """读取位于已分配段中的 C 字符串"""
+    for section in elf.iter_sections():
+        start = section['sh_addr']
+        if not loaded(section) or not start <= addr < start + section['sh_size']:
+            continue
+        data = section.data()[addr - start:]
+        return data[:data.find(b'\0')].decode(errors='replace')
+    return None
+
+
+def read_pointer(elf: ELFFile, addr: int) -> int | None:
+    """读取 addr 处的一个指针，topic_desc::name 是结构体的第一个成员"""
+    size = elf.elfclass // 8
+    for section in elf.iter_sections():
+        start = section['sh_addr']
+        if not loaded(section) or not start <= addr < start + section['sh_size']:
+            continue
+        raw = section.data()[addr - start:addr - start + size]
+        return int.from_bytes(raw, 'little' if elf.little_endian else 'big')
+    return None
+
+
+def collect(elf: ELFFile):
+    """返回 [(topic 名称, 字节数, 区域)]"""
+    symtab = elf.get_section_by_name('.symtab')
+    if not isinstance(symtab, SymbolTableSection):
+        sys.exit('topic_footprint: no symbol table in ELF')
+
+    instances = {}
+    names = {}
+    for sym in symtab.iter_symbols():
+        if sym['st_info']['type'] != 'STT_OBJECT' or not isinstance(sym['st_shndx'], int):
+            continue
+        if match := INSTANCE_RE.search(plain_name(sym.name)):
+            section = elf.get_section(sym['st_shndx']).name
+            instances[match.group(1)] = (sym['st_size'], region_of(section))
+        elif match := DESC_RE.search(plain_name(sym.name)):
+            ptr = read_pointer(elf, sym['st_value'])
+            name = read_cstring(elf, ptr) if ptr else None
+            if name:
+                names[match.group(1)] = name
+
+    return sorted((names.get(var, var), size, region) for var, (size, region) in instances.items())
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Report per-topic memory footprint')
+    parser.add_argument('elf', help='path to zephyr.elf')
+    args = parser.parse_args()
+
+    with open(args.elf, 'rb') as f:
+        topics = collect(ELFFile(f))
+
+    if not topics:
+        return
+
+    totals = defaultdict(int)
+    print(f"{'Topic':<32} {'Bytes':>8}  Region")
+    for name, size, region in topics:
+        print(f'{name:<32} {size:>8}  {region}')
+        totals[region] += size
+    print(', '.join(f'{region}: {size} B' for region, size in sorted(totals.items())))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""
+Topic 图的生成与检查。
+
+由 lib/Node/CMakeLists.txt 调用：
+    topic_graph.py elf zephyr.elf --out-dir <构建目录>
+        构建后读取 node_desc / topic_publisher 段，输出 topic_graph.dot 与 topic_graph.json；
+        有订阅者却没有任何发布者的 Topic 使构建失败（CONFIG_TOPIC_GRAPH）。
+    topic_graph.py scan --header <topic_graph.h> <源文件...>
+        CMake 配置时扫描应用源码中的声明，为有发布者但没有订阅者的 Topic 生成
+        OF_TOPIC_PRUNED_<变量名>（CONFIG_TOPIC_GRAPH_PRUNE）。
+"""
+
+import argparse
+import json
+import re
+import sys
+from pathlib import Path
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+from topic_footprint import DESC_RE, loaded, plain_name
+
+# ------------------------------------------------------------------ 源码扫描
+
+REGISTER_RE = re.compile(r'\bONE_(QUEUED_|LOANED_)?TOPIC_REGISTER(_IN)?\s*\(')
+CALLBACK_RE = re.compile(r'\bONE_TOPIC_CALLBACK\s*\(\s*(\w+)')
+LINK_RE = re.compile(r'\bONE_NODE_(PUBLISHES|SUBSCRIBES)\s*\(([^)]*)\)')
+PUBLISHER_RE = re.compile(r'\bONE_TOPIC_PUBLISHER\s*\(\s*(\w+)')
+COMMENT_RE = re.compile(r'//[^\n]*|/\*.*?\*/', re.S)
+
+
+def macro_args(text: str, start: int) -> list[str]:
+    """从左括号之后切分宏参数，忽略嵌套括号与模板尖括号中的逗号"""
+    args, depth, cur = [], 0, ''
+    for c in text[start:]:
+        if c in '(<{[':
+            depth += 1
+        elif c in ')>}]':
+            if depth == 0:
+                args.append(cur.strip())
+                return args
+            depth -= 1
+        elif c == ',' and depth == 0:
+            args.append(cur.strip())
+            cur = ''
+            continue
+        cur += c
+    return args
+
+
+def scan(sources: list[str]):
+    """返回 (plain Topic 变量 -> 名称, 有发布者的变量, 有订阅者的变量)"""
+    topics = {}
+    published, subscribed = set(), set()
+    for path in sources:
+        text = COMMENT_RE.sub('', Path(path).read_text(errors='replace'))
+        for match in REGISTER_RE.finditer(text):
+            args = macro_args(text, match.end())
+            if match.group(2):
+                args = args[1:]
+            if len(args) >= 3:
+                if not match.group(1):
+                    topics[args[1]] = args[2].strip('"')
+        for match in LINK_RE.finditer(text):
+            target = published if match.group(1) == 'PUBLISHES' else subscribed
+            target.update(v.strip() for v in match.group(2).split(',') if v.strip())
+        for match in PUBLISHER_RE.finditer(text):
+            published.add(match.group(1))
+        for match in CALLBACK_RE.finditer(text):
+            subscribed.add(match.group(1))
+    return topics, published, subscribed
+
+
+def cmd_scan(args):
+    topics, published, subscribed = scan(args.sources)
+    pruned = sorted(var for var in topics if var in published and var not in subscribed)
+
+    lines = ['/* 由 scripts/topic_graph.py 生成，请勿修改 */', '#ifndef OF_TOPIC_GRAPH_H', '#define OF_TOPIC_GRAPH_H', '']
+    lines += [f'#define OF_TOPIC_PRUNED_{var} 1 /* {topics[var]} */' for var in pruned]
+    lines += ['', '#endif', '']
+    content = '\n'.join(lines)
+
+    header = Path(args.header)
+    header.parent.mkdir(parents=True, exist_ok=True)
+    # 内容不变时不改写，避免所有包含它的文件重新编译
+    if not header.exists() or header.read_text() != content:
+        header.write_text(content)
+    for var in pruned:
+        print(f'topic_graph: pruning topic "{topics[var]}" ({var}), no subscribers')
+
+
+# ------------------------------------------------------------------ 构建后检查
+
+
+class Image:
+    """按地址读取已链接的 ELF"""
+
+    def __init__(self, elf: ELFFile):
+        self.elf = elf
+        self.ptr_size = elf.elfclass // 8
+        self.endian = 'little' if elf.little_endian else 'big'
+        symtab = elf.get_section_by_name('.symtab')
+        if not isinstance(symtab, SymbolTableSection):
+            sys.exit('topic_graph: no symbol table in ELF')
+        self.symbols = {sym.name: sym['st_value'] for sym in symtab.iter_symbols()}
+        self.objects = {sym.name: sym['st_value'] for sym in symtab.iter_symbols()
+                        if sym['st_info']['type'] == 'STT_OBJECT'}
+
+    def read(self, addr: int, size: int) -> bytes | None:
+        for section in self.elf.iter_sections():
+            start = section['sh_addr']
+            if not loaded(section) or not start <= addr < start + section['sh_size']:
+                continue
+            return section.data()[addr - start:addr - start + size]
+        return None
+
+    def uint(self, addr: int, size: int) -> int:
+        raw = self.read(addr, size)
+        return int.from_bytes(raw, self.endian) if raw else 0
+
+    def ptr(self, addr: int) -> int:
+        return self.uint(addr, self.ptr_size)
+
+    def cstring(self, addr: int) -> str:
+        data = b''
+        while addr and (chunk := self.read(addr, 64)):
+            data += chunk
+            if b'\0' in chunk:
+                break
+            addr += len(chunk)
+        return data[:data.find(b'\0')].decode(errors='replace') if b'\0' in data else data.decode(errors='replace')
+
+    def section_list(self, name: str) -> tuple[int, int]:
+        return self.symbols.get(f'_{name}_list_start', 0), self.symbols.get(f'_{name}_list_end', 0)
+
+
+# 与 Descriptor.hpp 中 topic_layout 的成员顺序一致
+LAYOUT_FIELDS = (
+    'desc_size', 'desc_name', 'desc_type_size', 'desc_footprint',
+    'node_size', 'node_name', 'node_publishes', 'node_subscribes', 'node_publish_cnt', 'node_subscribe_cnt',
+    'link_size', 'link_desc',
+    'publisher_size', 'publisher_name', 'publisher_link',
+)
+
+
+def read_layout(image: Image) -> dict[str, int]:
+    """读取 Node.cpp 写入 .topic_layout 段的描述符成员偏移与大小"""
+    section = image.elf.get_section_by_name('.topic_layout')
+    if section is None:
+        sys.exit('topic_graph: no .topic_layout section in ELF, is lib/Node/linker/node_info.ld linked?')
+    data = section.data()
+    if len(data) < 4 * len(LAYOUT_FIELDS):
+        sys.exit(f'topic_graph: .topic_layout has {len(data)} bytes, expected {4 * len(LAYOUT_FIELDS)}')
+    return {name: int.from_bytes(data[4 * i:4 * i + 4], image.endian) for i, name in enumerate(LAYOUT_FIELDS)}
+
+
+def collect(image: Image):
+    """返回 (topics, nodes, publishers)，描述符布局见 read_layout"""
+    lay = read_layout(image)
+
+    topics = {}
+
+    def topic_at(desc: int) -> str:
+        if desc not in topics:
+            topics[desc] = {
+                'name': image.cstring(image.ptr(desc + lay['desc_name'])),
+                'type_size': image.uint(desc + lay['desc_type_size'], 4),
+                'footprint': image.uint(desc + lay['desc_footprint'], 4),
+                'publishers': [],
+                'subscribers': [],
+            }
+        return topics[desc]['name']
+
+    # 没有出现在任何连接中的 Topic 也列入图中
+    for sym, addr in image.objects.items():
+        if DESC_RE.search(plain_name(sym)):
+            topic_at(addr)
+
+    def links(addr: int, count: int) -> list[int]:
+        return [image.ptr(addr + i * lay['link_size'] + lay['link_desc']) for i in range(count)]
+
+    nodes = []
+    start, end = image.section_list('node_desc')
+    for addr in range(start, end, lay['node_size']):
+        publishes = links(image.ptr(addr + lay['node_publishes']), image.uint(addr + lay['node_publish_cnt'], 1))
+        subscribes = links(image.ptr(addr + lay['node_subscribes']), image.uint(addr + lay['node_subscribe_cnt'], 1))
+        nodes.append({
+            'name': image.cstring(image.ptr(addr + lay['node_name'])),
+            'publishes': [topic_at(d) for d in publishes],
+            'subscribes': [topic_at(d) for d in subscribes],
+        })
+
+    publishers = []
+    start, end = image.section_list('topic_publisher')
+    for addr in range(start, end, lay['publisher_size']):
+        desc = image.ptr(addr + lay['publisher_link'] + lay['link_desc'])
+        publishers.append({'name': image.cstring(image.ptr(addr + lay['publisher_name'])), 'topic': topic_at(desc)})
+
+    by_name = {t['name']: t for t in topics.values()}
+    for node in nodes:
+        for name in node['publishes']:
+            by_name[name]['publishers'].append(node['name'])
+        for name in node['subscribes']:
+            by_name[name]['subscribers'].append(node['name'])
+    for pub in publishers:
+        by_name[pub['topic']]['publishers'].append(pub['name'])
+
+    return sorted(by_name.values(), key=lambda t: t['name']), nodes, publishers
+
+
+def write_dot(path: Path, topics, nodes, publishers):
+    lines = ['digraph topics {', '    rankdir=LR;', '    node [fontname="monospace"];']
+    for node in nodes:
+        lines.append(f'    "node:{node["name"]}" [label="{node["name"]}", shape=box];')
+    for pub in publishers:
+        lines.append(f'    "node:{pub["name"]}" [label="{pub["name"]}", shape=box, style=dashed];')
+    for topic in topics:
+        style = ', style=dashed' if not topic['subscribers'] else ''
+        lines.append(f'    "topic:{topic["name"]}" [label="{topic["name"]}\\n{topic["footprint"]} B", '
+                     f'shape=ellipse{style}];')
+        lines += [f'    "node:{n}" -> "topic:{topic["name"]}";' for n in topic['publishers']]
+        lines += [f'    "topic:{topic["name"]}" -> "node:{n}";' for n in topic['subscribers']]
+    lines.append('}')
+    path.write_text('\n'.join(lines) + '\n')
+
+
+def cmd_elf(args):
+    with open(args.elf, 'rb') as f:
+        topics, nodes, publishers = collect(Image(ELFFile(f)))
+
+    if not topics:
+        return
+
+    out_dir = Path(args.out_dir)
+    write_dot(out_dir / 'topic_graph.dot', topics, nodes, publishers)
+    (out_dir / 'topic_graph.json').write_text(
+        json.dumps({'topics': topics, 'nodes': nodes, 'publishers': publishers}, indent=2, ensure_ascii=False) + '\n')
+
+    errors = 0
+    for topic in topics:
+        if topic['subscribers'] and not topic['publishers']:
+            print(f'topic_graph: error: topic "{topic["name"]}" is subscribed by '
+                  f'{", ".join(topic["subscribers"])} but has no publisher '
+                  '(declare it with ONE_NODE_PUBLISHES or ONE_TOPIC_PUBLISHER)', file=sys.stderr)
+            errors += 1
+        elif topic['publishers'] and not topic['subscribers']:
+            print(f'topic_graph: topic "{topic["name"]}" has no subscribers ({topic["footprint"]} B), '
+                  'see CONFIG_TOPIC_GRAPH_PRUNE')
+    if errors:
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Topic graph generation and checks')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    elf = sub.add_parser('elf', help='emit DOT/JSON graph from a linked ELF and check wiring')
+    elf.add_argument('elf', help='path to zephyr.elf')
+    elf.add_argument('--out-dir', required=True, help='directory for topic_graph.dot/json')
+    elf.set_defaults(func=cmd_elf)
+
+    scan_cmd = sub.add_parser('scan', help='generate topic_graph.h with pruned topics')
+    scan_cmd.add_argument('--header', required=True, help='output header path')
+    scan_cmd.add_argument('sources', nargs='*', help='source files to scan')
+    scan_cmd.set_defaults(func=cmd_scan)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
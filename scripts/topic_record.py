@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+处理 Topic 录制导出文件。
+
+  topic_record.py extract serial.log match.bin   从串口日志中提取 topic record dump 的输出
+  topic_record.py show match.bin                 列出文件中的 Topic 与记录
+
+得到的 match.bin 可通过 CONFIG_NODE_REPLAY_FILE 在 native_sim 上回放。
+"""
+
+import argparse
+import re
+import struct
+import sys
+from collections import Counter
+
+MAGIC = 0x3152464F  # "OFR1"
+FILE_HEADER = struct.Struct('<IIHHI')
+RECORD_HEADER = struct.Struct('<HHI')
+LINE_RE = re.compile(r'OFREC:(END|[0-9a-fA-F]+)')
+
+
+def extract(log_path: str, out_path: str):
+    """取日志中最后一次完整的导出"""
+    dumps, current = [], None
+    with open(log_path, errors='replace') as f:
+        for line in f:
+            match = LINE_RE.search(line)
+            if not match:
+                continue
+            if match.group(1) == 'END':
+                if current is not None:
+                    dumps.append(current)
+                current = None
+                continue
+            chunk = bytes.fromhex(match.group(1))
+            if current is None:
+                current = bytearray()
+            current += chunk
+
+    if not dumps:
+        sys.exit(f'{log_path}: no complete OFREC dump found')
+    with open(out_path, 'wb') as f:
+        f.write(dumps[-1])
+    print(f'{out_path}: {len(dumps[-1])} bytes')
+
+
+def parse(data: bytes):
+    """返回 (每秒周期数, [(名称, 大小)], [(topic 序号, 时间戳, 数据)])"""
+    magic, cycles_per_sec, topic_cnt, _, record_bytes = FILE_HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.exit('not a topic record file')
+
+    pos = FILE_HEADER.size
+    topics = []
+    for _ in range(topic_cnt):
+        size, name_len = struct.unpack_from('<HB', data, pos)
+        pos += 3
+        topics.append((data[pos:pos + name_len].decode(), size))
+        pos += name_len
+
+    records = []
+    end = pos + record_bytes
+    while pos < end:
+        topic, size, stamp = RECORD_HEADER.unpack_from(data, pos)
+        pos += RECORD_HEADER.size
+        records.append((topic, stamp, data[pos:pos + size]))
+        pos += size
+    return cycles_per_sec, topics, records
+
+
+def show(path: str):
+    with open(path, 'rb') as f:
+        cycles_per_sec, topics, records = parse(f.read())
+
+    counts = Counter(topic for topic, _, _ in records)
+    duration = 0
+    for (_, prev, _), (_, cur, _) in zip(records, records[1:]):
+        duration += (cur - prev) & 0xFFFFFFFF
+
+    print(f'{len(records)} records over {duration / cycles_per_sec:.3f} s ({cycles_per_sec} cycles/s)')
+    print(f"{'Id':>3}  {'Topic':<32} {'Size':>6} {'Records':>8}")
+    for i, (name, size) in enumerate(topics):
+        if counts[i]:
+            print(f'{i:>3}  {name:<32} {size:>6} {counts[i]:>8}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Topic record dump tools')
+    sub = parser.add_subparsers(dest='cmd', required=True)
+    p_extract = sub.add_parser('extract', help='extract a dump from a serial log')
+    p_extract.add_argument('log')
+    p_extract.add_argument('out')
+    p_show = sub.add_parser('show', help='summarize a dump file')
+    p_show.add_argument('dump')
+    args = parser.parse_args()
+
+    if args.cmd == 'extract':
+        extract(args.log, args.out)
+    else:
+        show(args.dump)
+
+
+if __name__ == '__main__':
+    main()
@@ -179,7 +179,7 @@ def parse_module_info(cmd, module_path: Path) -> dict:
                 info['node_class'] = match.group(1)
 
             # 查找Topic注册
-            match = re.search(r'ONE_TOPIC_REGISTER\((\w+),\s*(\w+),\s*"([^"]+)"\)', content)
+            match = re.search(r'ONE_TOPIC_REGISTER(?:_IN\(\w+,\s*|\()(\w+),\s*(\w+),\s*"([^"]+)"', content)
             if match:
                 info['data_class'] = match.group(1)
                 info['topic_var'] = match.group(2)
@@ -26,6 +26,13 @@ int main()
         LOG_INF("quat: %f, %f, %f, %f;", w, qx, qy, qz);
         auto& [p, r, y] = euler_angle;
         LOG_INF("euler: %f, %f, %f;", p, r, y);
+#if CONFIG_IMU_HUB_HISTORY_N > 0
+        // 模拟自瞄按 10 ms 前的图像时间戳回溯姿态
+        if (const auto past = ImuHub::getAttitudeAt(k_cycle_get_32() - k_ms_to_cyc_ceil32(10)))
+        {
+            LOG_INF("quat 10 ms ago: %f, %f, %f, %f;", past->w, past->x, past->y, past->z);
+        }
+#endif
         uint32_t load = cpu_load_get(false);
         LOG_INF("cpu: %u.%u%%", load / 10, load % 10);
         k_sleep(K_MSEC(500));
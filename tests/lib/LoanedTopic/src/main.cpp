@@ -0,0 +1,252 @@
+// LoanedTopic 测试：先单线程检查池耗尽、句柄释放后块回到池中，
+// 再让两个写者并发发布、一个读者 wait_next() 后 acquire()，检查取得的块不比 wait_next() 报告的发布更旧、
+// 读到的序号不回退，结束后池中的块全部归还。
+// 多核运行：west build -b qemu_x86_64 tests/lib/LoanedTopic -t run
+// 单核平台上同样可以运行，此时只验证抢占下的正确性。
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/Node/LoanedTopic.hpp>
+
+LOG_MODULE_REGISTER(loaned_topic_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    constexpr size_t WRITER_CNT = 2;
+    constexpr size_t STACK_SIZE = 1024;
+    constexpr int32_t RUN_TIME_MS = 1000;
+    constexpr int PRIORITY = 5;
+
+    struct Data
+    {
+        uint32_t writer;
+        uint32_t counter;
+    };
+
+    // ---------------------------------------------------------------- 单线程检查
+
+    bool check_exhaustion()
+    {
+        LoanedTopic<Data, 3> topic;
+
+        Loan<Data> a = topic.loan();
+        Loan<Data> b = topic.loan();
+        Loan<Data> c = topic.loan();
+        if (!a || !b || !c)
+        {
+            LOG_ERR("loan failed before the pool is exhausted");
+            return false;
+        }
+        if (topic.loan() || topic.loan_failures() != 1 || topic.available() != 0)
+        {
+            LOG_ERR("loan succeeded on an exhausted pool, failures: %u", topic.loan_failures());
+            return false;
+        }
+
+        // 未发布就析构的 Loan 直接回到池中
+        b.reset();
+        if (topic.available() != 1 || !topic.loan())
+        {
+            LOG_ERR("dropped loan did not return to the pool");
+            return false;
+        }
+        return true;
+    }
+
+    bool check_release()
+    {
+        LoanedTopic<Data, 3> topic;
+
+        if (topic.acquire() || topic.generation() != 0)
+        {
+            LOG_ERR("acquire returned a block before any publish");
+            return false;
+        }
+
+        Loan<Data> first = topic.loan();
+        *first = {0, 1};
+        if (topic.publish(std::move(first)) != 1 || first)
+        {
+            LOG_ERR("first publish");
+            return false;
+        }
+
+        // 两个句柄共享同一块，第一块被替换后仍由它们持有
+        Shared<Data> s1 = topic.acquire();
+        Shared<Data> s2 = s1;
+        Loan<Data> second = topic.loan();
+        *second = {0, 2};
+        topic.publish(std::move(second));
+        Loan<Data> third = topic.loan();
+
+        if (!s1 || s1->counter != 1 || s2.seq() != 1 || topic.acquire()->counter != 2)
+        {
+            LOG_ERR("shared handle does not keep the replaced block");
+            return false;
+        }
+        if (topic.available() != 0)
+        {
+            LOG_ERR("held block returned early, available: %u", static_cast<unsigned>(topic.available()));
+            return false;
+        }
+
+        s1.reset();
+        if (topic.available() != 0)
+        {
+            LOG_ERR("block returned while a handle is still held");
+            return false;
+        }
+        s2.reset();
+        if (topic.available() != 1)
+        {
+            LOG_ERR("block did not return after the last handle was released");
+            return false;
+        }
+
+        // 被替换的最新块同样在最后一个句柄释放后归还
+        third.reset();
+        Loan<Data> fourth = topic.loan();
+        topic.publish(std::move(fourth));
+        if (topic.available() != 2 || topic.generation() != 3)
+        {
+            LOG_ERR("replaced latest block was not returned, available: %u",
+                    static_cast<unsigned>(topic.available()));
+            return false;
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------- 并发发布
+
+    // 块数 = Topic 持有的 1 块 + 每个写者 1 块 + 读者 1 个句柄，再留一块余量
+    constexpr size_t POOL_N = WRITER_CNT + 3;
+    LoanedTopic<Data, POOL_N> g_topic;
+
+    atomic_t g_running = ATOMIC_INIT(1);
+    atomic_t g_publishes = ATOMIC_INIT(0);
+    atomic_t g_wakeups = ATOMIC_INIT(0);
+    atomic_t g_stale = ATOMIC_INIT(0);
+    atomic_t g_regress = ATOMIC_INIT(0);
+
+    K_THREAD_STACK_ARRAY_DEFINE(writer_stacks, WRITER_CNT, STACK_SIZE);
+    K_THREAD_STACK_DEFINE(reader_stack, STACK_SIZE);
+    k_thread writer_threads[WRITER_CNT];
+    k_thread reader_thread;
+
+    void writer_entry(void* p1, void*, void*)
+    {
+        const auto writer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p1));
+        uint32_t counter{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 64; ++burst)
+            {
+                Loan<Data> loan = g_topic.loan();
+                if (!loan)
+                {
+                    k_yield();
+                    continue;
+                }
+                *loan = {writer, ++counter};
+                g_topic.publish(std::move(loan));
+                atomic_inc(&g_publishes);
+            }
+            k_yield();
+        }
+    }
+
+    void reader_entry(void*, void*, void*)
+    {
+        uint32_t seen = g_topic.generation();
+        uint32_t last_seq{};
+        while (atomic_get(&g_running))
+        {
+            if (!g_topic.wait_next(seen, K_MSEC(10)))
+            {
+                continue;
+            }
+            atomic_inc(&g_wakeups);
+
+            const Shared<Data> val = g_topic.acquire();
+            if (!val || static_cast<int32_t>(val.seq() - seen) < 0)
+            {
+                atomic_inc(&g_stale);
+            }
+            if (val && static_cast<int32_t>(val.seq() - last_seq) < 0)
+            {
+                atomic_inc(&g_regress);
+            }
+            if (val)
+            {
+                last_seq = val.seq();
+            }
+        }
+    }
+
+    // 线程创建后暂不启动，固定到 cpu 后再运行；未开启 CPU 掩码时由调度器自由分配
+    void spawn(k_thread& thread, k_thread_stack_t* stack, const k_thread_entry_t entry, const uintptr_t arg,
+               const int cpu)
+    {
+        k_thread_create(&thread, stack, STACK_SIZE, entry, reinterpret_cast<void*>(arg), nullptr, nullptr,
+                        PRIORITY, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+        k_thread_cpu_pin(&thread, cpu);
+#else
+        ARG_UNUSED(cpu);
+#endif
+        k_thread_start(&thread);
+    }
+
+    bool check_concurrent()
+    {
+        const unsigned int cpus = arch_num_cpus();
+        for (size_t i = 0; i < WRITER_CNT; ++i)
+        {
+            spawn(writer_threads[i], writer_stacks[i], writer_entry, i + 1, static_cast<int>(i % cpus));
+        }
+        spawn(reader_thread, reader_stack, reader_entry, 0, static_cast<int>(WRITER_CNT % cpus));
+
+        k_msleep(RUN_TIME_MS);
+        atomic_clear(&g_running);
+        for (auto& thread : writer_threads)
+        {
+            k_thread_join(&thread, K_FOREVER);
+        }
+        k_thread_join(&reader_thread, K_FOREVER);
+
+        // 所有句柄都已释放，只剩 Topic 持有的最新块
+        const auto stale = atomic_get(&g_stale);
+        const auto regress = atomic_get(&g_regress);
+        const size_t available = g_topic.available();
+        LOG_INF("publishes: %ld, wakeups: %ld, stale: %ld, seq regressions: %ld, loan failures: %u, free blocks: %u",
+                atomic_get(&g_publishes), atomic_get(&g_wakeups), stale, regress, g_topic.loan_failures(),
+                static_cast<unsigned>(available));
+
+        const Shared<Data> last = g_topic.acquire();
+        if (!last || last.seq() != g_topic.generation())
+        {
+            LOG_ERR("latest block seq %u does not match generation %u", last ? last.seq() : 0,
+                    g_topic.generation());
+            return false;
+        }
+        return stale == 0 && regress == 0 && available == POOL_N - 1;
+    }
+}
+
+int main()
+{
+    bool pass = check_exhaustion();
+    pass &= check_release();
+    pass &= check_concurrent();
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "ReadBench.hpp"
+
+#include <cstring>
+
+#include <zephyr/kernel.h>
+
+#include <OF/lib/Node/LoanedTopic.hpp>
+#include <OF/lib/Node/Topic.hpp>
+
+namespace
+{
+    constexpr uint32_t ROUNDS = 1000;
+
+    uint32_t g_bytes_copied{};
+
+    // 每次拷贝都把自身大小累加到 g_bytes_copied 的测试载荷
+    template <size_t Size>
+    struct Payload
+    {
+        Payload() = default;
+
+        Payload(const Payload& other)
+        {
+            *this = other;
+        }
+
+        Payload& operator=(const Payload& other)
+        {
+            std::memcpy(bytes, other.bytes, Size);
+            g_bytes_copied += Size;
+            return *this;
+        }
+
+        uint8_t bytes[Size]{};
+    };
+
+    template <typename Func>
+    void measure(const size_t size, const char* method, const Func& func)
+    {
+        g_bytes_copied = 0;
+        const uint32_t start = k_cycle_get_32();
+        for (uint32_t i = 0; i < ROUNDS; ++i)
+        {
+            func();
+        }
+        const uint32_t cycles = k_cycle_get_32() - start;
+        printk("| %5u | %-10s | %11u | %11u |\n", static_cast<uint32_t>(size), method,
+               g_bytes_copied / ROUNDS, cycles / ROUNDS);
+    }
+
+    template <size_t Size>
+    void bench_payload()
+    {
+        using Data = Payload<Size>;
+        static OF::Topic<Data> topic;
+        static Data storage;
+        volatile uint8_t sink{};
+
+        storage.bytes[Size - 1] = 1;
+        topic.write(storage);
+
+        measure(Size, "read()", [&]
+        {
+            const Data val = topic.read();
+            sink = val.bytes[Size - 1];
+        });
+        measure(Size, "read_into", [&]
+        {
+            topic.read_into(storage);
+            sink = storage.bytes[Size - 1];
+        });
+        measure(Size, "read(func)", [&]
+        {
+            sink = topic.read([](const Data& val) { return val.bytes[Size - 1]; });
+        });
+
+        // 借出式 Topic：发布与读取都只传递块的引用
+        static OF::LoanedTopic<Data, 3> loaned;
+        if (OF::Loan<Data> loan = loaned.loan())
+        {
+            loan->bytes[Size - 1] = 1;
+            loaned.publish(std::move(loan));
+        }
+        measure(Size, "acquire()", [&]
+        {
+            const OF::Shared<Data> val = loaned.acquire();
+            sink = val->bytes[Size - 1];
+        });
+    }
+}
+
+void run_read_bench()
+{
+    printk("| Bytes | Method     | Copied/read | Cycles/read |\n");
+    printk("|-------|------------|-------------|-------------|\n");
+    bench_payload<16>();
+    bench_payload<256>();
+    bench_payload<2048>();
+}
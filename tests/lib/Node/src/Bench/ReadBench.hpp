@@ -0,0 +1,7 @@
+#ifndef OF_LIB_NODE_TEST_READBENCH_HPP
+#define OF_LIB_NODE_TEST_READBENCH_HPP
+
+// 比较 read() / read_into() / read(func) 与 LoanedTopic::acquire() 每次读取拷贝的字节数与周期数
+void run_read_bench();
+
+#endif //OF_LIB_NODE_TEST_READBENCH_HPP
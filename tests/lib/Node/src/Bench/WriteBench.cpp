@@ -0,0 +1,59 @@
+#include "WriteBench.hpp"
+
+#include <zephyr/kernel.h>
+
+#include <OF/lib/Node/Macro.hpp>
+
+using namespace OF;
+
+namespace
+{
+    constexpr uint32_t ROUNDS = 1000;
+
+    struct BenchData
+    {
+        uint32_t value;
+    };
+
+    volatile uint32_t g_sink{};
+
+    void on_bench_1(const BenchData& data) { g_sink = data.value; }
+    void on_bench_4a(const BenchData& data) { g_sink = data.value; }
+    void on_bench_4b(const BenchData& data) { g_sink = data.value; }
+    void on_bench_4c(const BenchData& data) { g_sink = data.value; }
+    void on_bench_4d(const BenchData& data) { g_sink = data.value; }
+}
+
+ONE_TOPIC_REGISTER(BenchData, topic_bench_0, "bench_cb0");
+ONE_TOPIC_REGISTER(BenchData, topic_bench_1, "bench_cb1");
+ONE_TOPIC_REGISTER(BenchData, topic_bench_4, "bench_cb4");
+
+ONE_TOPIC_CALLBACK(topic_bench_1, on_bench_1, Inline);
+ONE_TOPIC_CALLBACK(topic_bench_4, on_bench_4a, Inline);
+ONE_TOPIC_CALLBACK(topic_bench_4, on_bench_4b, Inline);
+ONE_TOPIC_CALLBACK(topic_bench_4, on_bench_4c, Inline);
+ONE_TOPIC_CALLBACK(topic_bench_4, on_bench_4d, Inline);
+
+namespace
+{
+    template <typename TopicT>
+    void measure(const char* name, TopicT& topic)
+    {
+        const uint32_t start = k_cycle_get_32();
+        for (uint32_t i = 0; i < ROUNDS; ++i)
+        {
+            topic.write({i});
+        }
+        const uint32_t cycles = k_cycle_get_32() - start;
+        printk("| %-10s | %12u |\n", name, cycles / ROUNDS);
+    }
+}
+
+void run_write_bench()
+{
+    printk("| Callbacks  | Cycles/write |\n");
+    printk("|------------|--------------|\n");
+    measure("0", topic_bench_0);
+    measure("1 inline", topic_bench_1);
+    measure("4 inline", topic_bench_4);
+}
@@ -0,0 +1,7 @@
+#ifndef OF_LIB_NODE_TEST_WRITEBENCH_HPP
+#define OF_LIB_NODE_TEST_WRITEBENCH_HPP
+
+// 比较挂有 0 / 1 / 4 个 Inline 回调时 write() 的周期数，需在 start_all_nodes() 之前调用
+void run_write_bench();
+
+#endif //OF_LIB_NODE_TEST_WRITEBENCH_HPP
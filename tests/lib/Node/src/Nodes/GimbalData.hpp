@@ -1,8 +1,16 @@
 #ifndef OF_LIB_NODE_TEST_GIMBALDATA_HPP
 #define OF_LIB_NODE_TEST_GIMBALDATA_HPP
 
+#include <OF/utils/FormatSink.hpp>
+
 struct GimbalData
 {
     float gimbal_yaw;
+
+    // 未开启 CONFIG_CBPRINTF_FP_SUPPORT 时按千分之一输出整数
+    void format(OF::FormatSink& sink) const
+    {
+        sink.print("yaw: %d/1000", static_cast<int>(gimbal_yaw * 1000));
+    }
 };
 #endif //OF_LIB_NODE_TEST_GIMBALDATA_HPP
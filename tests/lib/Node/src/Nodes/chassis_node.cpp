@@ -4,8 +4,9 @@
 
 using namespace OF;
 
-extern Topic<GimbalData>& topic_gimbal;
-ONE_TOPIC_REGISTER(ChassisData, topic_chassis, "chassis_data");
+ONE_TOPIC_DECLARE(GimbalData, topic_gimbal, .depth = 4, .align = OF::SLOT_ALIGN_PACKED, .deadline_ms = 150,
+                  .liveliness_ms = 1000);
+ONE_TOPIC_REGISTER_IN(DMA, ChassisData, topic_chassis, "chassis_data");
 
 class ChassisNode : public Node<ChassisNode>
 {
@@ -15,6 +16,8 @@ public:
         static constexpr size_t stack_size = 2048;
         static constexpr int priority = 5;
         static constexpr const char* name = "chassis";
+        ONE_NODE_PUBLISHES(topic_chassis);
+        ONE_NODE_SUBSCRIBES(topic_gimbal);
     };
 
     struct Config
@@ -29,15 +32,24 @@ public:
     void run()
     {
         float x{}, y{};
+        uint32_t gimbal_gen = topic_gimbal.generation();
         while (true)
         {
             x += 1.5f;
             y -= 1.5f;
             topic_chassis.write({x, y});
 
-            const auto [gimbal_yaw] = topic_gimbal.read();
-            printk("Chassis: Read from Gimbal: %f\n", static_cast<double>(gimbal_yaw));
-            k_msleep(100);
+            // 云台发布后立即被唤醒，不再依赖 k_msleep 轮询
+            if (!topic_gimbal.wait_next(gimbal_gen, K_MSEC(500)))
+            {
+                printk("Chassis: Gimbal topic timeout\n");
+                continue;
+            }
+
+            GimbalData gimbal{};
+            const TopicStatus status = topic_gimbal.read_checked(gimbal);
+            printk("Chassis: Read from Gimbal (%s): %f\n", topic_status_str(status),
+                   static_cast<double>(gimbal.gimbal_yaw));
         }
     }
 
@@ -3,8 +3,10 @@
 #include "ChassisData.hpp"
 
 using namespace OF;
-extern Topic<ChassisData>& topic_chassis;
-ONE_TOPIC_REGISTER(GimbalData, topic_gimbal, "gimbal_data");
+ONE_TOPIC_DECLARE(ChassisData, topic_chassis);
+// 4 字节的云台数据只需少量紧凑排列的槽位；每 100 ms 发布一次，超过 150 ms 视为过期，1 s 未发布视为失效
+ONE_TOPIC_REGISTER(GimbalData, topic_gimbal, "gimbal_data", .depth = 4, .align = OF::SLOT_ALIGN_PACKED,
+                   .deadline_ms = 150, .liveliness_ms = 1000);
 
 
 class GimbalNode : public Node<GimbalNode>
@@ -15,6 +17,8 @@ public:
         static constexpr size_t stack_size = 1024;
         static constexpr int priority = 5;
         static constexpr const char* name = "gimbal";
+        ONE_NODE_PUBLISHES(topic_gimbal);
+        ONE_NODE_SUBSCRIBES(topic_chassis);
     };
 
     bool init() { return true; }
@@ -22,13 +26,23 @@ public:
     void run()
     {
         float yaw{};
+        uint32_t last_seq{};
+        uint32_t last_stamp{};
         while (true)
         {
             yaw += 0.1f;
             topic_gimbal.write({yaw});
 
-            const auto [x, y] = topic_chassis.read();
-            printk("Gimbal: Read from chassis: %f, %f \n", static_cast<double>(x), static_cast<double>(y));
+            // 序号未变说明底盘没有新发布，跳过重复处理
+            const auto [chassis, seq, stamp] = topic_chassis.read_with_meta();
+            if (seq != last_seq)
+            {
+                const uint32_t dt_us = k_cyc_to_us_floor32(stamp - last_stamp);
+                printk("Gimbal: Read from chassis #%u (dt %u us): %f, %f \n", seq, dt_us,
+                       static_cast<double>(chassis.chassis_x), static_cast<double>(chassis.chassis_y));
+                last_seq = seq;
+                last_stamp = stamp;
+            }
             k_msleep(100);
         }
     }
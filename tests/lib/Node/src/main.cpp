@@ -4,6 +4,9 @@
 
 #include <OF/lib/Node/NodeManager.hpp>
 
+#include "Bench/ReadBench.hpp"
+#include "Bench/WriteBench.hpp"
+
 
 LOG_MODULE_REGISTER(node_test, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -14,6 +17,9 @@ int main()
 {
     LOG_INF("main");
 
+    run_read_bench();
+    run_write_bench();
+
     start_all_nodes();
 
     while (true)
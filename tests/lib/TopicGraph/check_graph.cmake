@@ -0,0 +1,102 @@
+# 检查 tests/lib/TopicGraph 构建后生成的 topic_graph.json 与 topic_graph.dot
+# 用法：cmake -DGRAPH_DIR=<构建目录> -P check_graph.cmake
+
+file(READ ${GRAPH_DIR}/topic_graph.json graph_json)
+file(READ ${GRAPH_DIR}/topic_graph.dot graph_dot)
+
+# 把 JSON 数组读成 CMake 列表
+function(json_list out)
+    string(JSON count LENGTH "${graph_json}" ${ARGN})
+    set(items "")
+    if (count GREATER 0)
+        math(EXPR last "${count} - 1")
+        foreach (i RANGE ${last})
+            string(JSON item GET "${graph_json}" ${ARGN} ${i})
+            list(APPEND items ${item})
+        endforeach ()
+    endif ()
+    set(${out} "${items}" PARENT_SCOPE)
+endfunction()
+
+# Topic 按名称排序输出；expect_topic(<名称> <类型大小> PUBLISHERS ... SUBSCRIBERS ...)
+function(expect_topic name type_size)
+    cmake_parse_arguments(ARG "" "" "PUBLISHERS;SUBSCRIBERS" ${ARGN})
+    string(JSON count LENGTH "${graph_json}" topics)
+    math(EXPR last "${count} - 1")
+    foreach (i RANGE ${last})
+        string(JSON topic_name GET "${graph_json}" topics ${i} name)
+        if (topic_name STREQUAL name)
+            string(JSON size GET "${graph_json}" topics ${i} type_size)
+            json_list(publishers topics ${i} publishers)
+            json_list(subscribers topics ${i} subscribers)
+            if (NOT size EQUAL type_size OR NOT "${publishers}" STREQUAL "${ARG_PUBLISHERS}"
+                    OR NOT "${subscribers}" STREQUAL "${ARG_SUBSCRIBERS}")
+                message(FATAL_ERROR "topic_graph: '${name}' has size ${size}, publishers [${publishers}], "
+                        "subscribers [${subscribers}]; expected ${type_size}, [${ARG_PUBLISHERS}], [${ARG_SUBSCRIBERS}]")
+            endif ()
+            return()
+        endif ()
+    endforeach ()
+    message(FATAL_ERROR "topic_graph: '${name}' missing from topic_graph.json")
+endfunction()
+
+function(expect_dot line)
+    string(FIND "${graph_dot}" "${line}" pos)
+    if (pos EQUAL -1)
+        message(FATAL_ERROR "topic_graph: '${line}' missing from topic_graph.dot")
+    endif ()
+endfunction()
+
+string(JSON count LENGTH "${graph_json}" topics)
+if (NOT count EQUAL 5)
+    message(FATAL_ERROR "topic_graph: ${count} topics in topic_graph.json, expected 5")
+endif ()
+set(names "")
+foreach (i RANGE 4)
+    string(JSON topic_name GET "${graph_json}" topics ${i} name)
+    list(APPEND names ${topic_name})
+endforeach ()
+if (NOT "${names}" STREQUAL "cb;dead;dead_in;queued;wired")
+    message(FATAL_ERROR "topic_graph: topics are [${names}]")
+endif ()
+
+expect_topic(wired 4 PUBLISHERS producer SUBSCRIBERS consumer)
+expect_topic(dead 4 PUBLISHERS producer)
+expect_topic(dead_in 4 PUBLISHERS dead_isr)
+expect_topic(cb 4 PUBLISHERS producer)
+expect_topic(queued 4 PUBLISHERS producer)
+
+# expect_node(<名称> <publishes|subscribes> <Topic 名称...>)
+function(expect_node name key)
+    string(JSON count LENGTH "${graph_json}" nodes)
+    math(EXPR last "${count} - 1")
+    foreach (i RANGE ${last})
+        string(JSON node_name GET "${graph_json}" nodes ${i} name)
+        if (node_name STREQUAL name)
+            json_list(links nodes ${i} ${key})
+            if (NOT "${links}" STREQUAL "${ARGN}")
+                message(FATAL_ERROR "topic_graph: node '${name}' ${key} [${links}], expected [${ARGN}]")
+            endif ()
+            return()
+        endif ()
+    endforeach ()
+    message(FATAL_ERROR "topic_graph: node '${name}' missing from topic_graph.json")
+endfunction()
+
+expect_node(producer publishes wired dead cb queued)
+expect_node(producer subscribes)
+expect_node(consumer publishes)
+expect_node(consumer subscribes wired)
+
+# Node 与外部发布者为方框，没有订阅者的 Topic 为虚线
+expect_dot("\"node:producer\" [label=\"producer\", shape=box];")
+expect_dot("\"node:dead_isr\" [label=\"dead_isr\", shape=box, style=dashed];")
+expect_dot("\"node:producer\" -> \"topic:wired\";")
+expect_dot("\"topic:wired\" -> \"node:consumer\";")
+expect_dot("\"node:dead_isr\" -> \"topic:dead_in\";")
+string(REGEX MATCH "\"topic:dead\" \\[[^]]*style=dashed\\];" dead_dashed "${graph_dot}")
+if (NOT dead_dashed)
+    message(FATAL_ERROR "topic_graph: topic 'dead' is not dashed in topic_graph.dot")
+endif ()
+
+message(STATUS "topic_graph: graph checks passed")
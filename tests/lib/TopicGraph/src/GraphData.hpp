@@ -0,0 +1,11 @@
+#ifndef GRAPH_DATA_HPP
+#define GRAPH_DATA_HPP
+
+#include <cstdint>
+
+struct GraphData
+{
+    uint32_t value;
+};
+
+#endif //GRAPH_DATA_HPP
@@ -0,0 +1,172 @@
+// Topic 图测试：CONFIG_TOPIC_GRAPH_PRUNE 按源码中的声明裁剪没有订阅者的 Topic，
+// 运行时检查被裁剪与保留的 Topic 的行为；topic_graph.dot / topic_graph.json 由 check_graph.cmake 在构建后检查。
+// 运行：west build -b native_sim tests/lib/TopicGraph -t run
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/Node/Macro.hpp>
+#include <OF/lib/Node/NodeManager.hpp>
+
+#include "GraphData.hpp"
+
+LOG_MODULE_REGISTER(topic_graph_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+ONE_TOPIC_DECLARE(GraphData, topic_wired, .depth = 4);
+ONE_TOPIC_DECLARE(GraphData, topic_dead, .depth = 8);
+ONE_TOPIC_DECLARE(GraphData, topic_dead_in);
+ONE_TOPIC_DECLARE(GraphData, topic_cb);
+ONE_QUEUED_TOPIC_DECLARE(GraphData, topic_queued);
+
+// topic_graph.py scan 的结果：扫描整个应用的源码，与声明所在的文件无关
+static_assert(IS_ENABLED(OF_TOPIC_PRUNED_topic_dead));
+static_assert(IS_ENABLED(OF_TOPIC_PRUNED_topic_dead_in));
+static_assert(!IS_ENABLED(OF_TOPIC_PRUNED_topic_wired));
+static_assert(!IS_ENABLED(OF_TOPIC_PRUNED_topic_cb));
+static_assert(!IS_ENABLED(OF_TOPIC_PRUNED_topic_queued));
+
+static_assert(std::remove_reference_t<decltype(topic_dead)>::options.pruned);
+static_assert(!std::remove_reference_t<decltype(topic_wired)>::options.pruned);
+
+namespace
+{
+    uint32_t g_cb_value;
+
+    void on_cb(const GraphData& data)
+    {
+        g_cb_value = data.value;
+    }
+}
+
+ONE_TOPIC_CALLBACK(topic_cb, on_cb, Inline);
+
+class ProducerNode : public Node<ProducerNode>
+{
+public:
+    struct Meta
+    {
+        static constexpr size_t stack_size = 512;
+        static constexpr int priority = 5;
+        static constexpr const char* name = "producer";
+        ONE_NODE_PUBLISHES(topic_wired, topic_dead, topic_cb, topic_queued);
+    };
+
+    bool init() { return true; }
+
+    void run()
+    {
+        topic_wired.write({1});
+        topic_dead.write({1});
+        topic_cb.write({1});
+        topic_queued.write({1});
+    }
+
+    void cleanup()
+    {
+    }
+};
+
+class ConsumerNode : public Node<ConsumerNode>
+{
+public:
+    struct Meta
+    {
+        static constexpr size_t stack_size = 512;
+        static constexpr int priority = 5;
+        static constexpr const char* name = "consumer";
+        ONE_NODE_SUBSCRIBES(topic_wired);
+    };
+
+    bool init() { return true; }
+
+    void run()
+    {
+        [[maybe_unused]] const GraphData data = topic_wired.read();
+    }
+
+    void cleanup()
+    {
+    }
+};
+
+// 只用于生成 Topic 图，测试不启动这两个 Node
+ONE_NODE_REGISTER(ProducerNode);
+ONE_NODE_REGISTER(ConsumerNode);
+
+namespace
+{
+    bool check_pruned()
+    {
+        // 写入直接丢弃，序号恒为 0，不占缓冲槽位
+        if (topic_dead.write({42}) != 0 || topic_dead.update([](GraphData& data) { data.value = 7; }) != 0 ||
+            topic_dead_in.write({42}) != 0)
+        {
+            LOG_ERR("FAIL: pruned topic accepted a write");
+            return false;
+        }
+
+        const topic_desc* dead = find_topic("dead");
+        const topic_desc* wired = find_topic("wired");
+        if (dead == nullptr || wired == nullptr)
+        {
+            LOG_ERR("FAIL: topic not registered");
+            return false;
+        }
+        // 与未裁剪的同类型 Topic 相比至少省下 8 个槽位的数据
+        constexpr size_t unpruned = sizeof(ONE_TOPIC_TYPE(GraphData, .depth = 8));
+        if (dead->footprint + 8 * sizeof(GraphData) > unpruned || dead->meta_func(dead).seq != 0)
+        {
+            LOG_ERR("FAIL: pruned topic footprint %u, seq %u", dead->footprint, dead->meta_func(dead).seq);
+            return false;
+        }
+
+        char buf[32];
+        FormatSink sink(buf);
+        if (dead->format_func(dead, sink) != 0 || std::string_view(sink.c_str()) != "pruned")
+        {
+            LOG_ERR("FAIL: pruned topic formats as '%s'", sink.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool check_kept()
+    {
+        if (topic_wired.write({3}) == 0 || topic_wired.read().value != 3)
+        {
+            LOG_ERR("FAIL: wired topic lost a write");
+            return false;
+        }
+
+        // 只有回调订阅的 Topic 没有被裁剪，回调照常执行
+        topic_cb.write({5});
+        if (g_cb_value != 5)
+        {
+            LOG_ERR("FAIL: callback on 'cb' saw %u", g_cb_value);
+            return false;
+        }
+
+        auto cursor = topic_queued.subscribe();
+        topic_queued.write({9});
+        uint32_t queued{};
+        const auto result = topic_queued.poll(cursor, [&queued](const GraphData& data) { queued = data.value; });
+        if (result.received != 1 || queued != 9)
+        {
+            LOG_ERR("FAIL: queued topic lost a write");
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    if (!check_pruned() || !check_kept())
+    {
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
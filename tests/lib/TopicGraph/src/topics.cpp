@@ -0,0 +1,20 @@
+// 各 Topic 的注册与 Node 之外的发布者；连接关系见 main.cpp 中 Node 的 Meta
+#include <OF/lib/Node/Macro.hpp>
+
+#include "GraphData.hpp"
+
+// 有订阅者，保留
+ONE_TOPIC_REGISTER(GraphData, topic_wired, "wired", .depth = 4);
+
+// 只有发布者，裁剪；注释中的声明不算订阅：ONE_NODE_SUBSCRIBES(topic_dead)
+ONE_TOPIC_REGISTER(GraphData, topic_dead, "dead", .depth = 8);
+
+// 带存放区域参数的注册，只有 Node 之外的发布者，裁剪
+ONE_TOPIC_REGISTER_IN(FAST, GraphData, topic_dead_in, "dead_in");
+ONE_TOPIC_PUBLISHER(topic_dead_in, "dead_isr");
+
+/* 只通过 ONE_TOPIC_CALLBACK 订阅，保留 */
+ONE_TOPIC_REGISTER(GraphData, topic_cb, "cb");
+
+// 只裁剪普通 Topic，QueuedTopic 即使没有订阅者也保留
+ONE_QUEUED_TOPIC_REGISTER(GraphData, topic_queued, "queued");
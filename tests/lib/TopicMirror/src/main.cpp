@@ -0,0 +1,214 @@
+// TopicMirror 测试：用记录数据包的假 Bridge 代替串口，按上位机的方式以 (topic, seq) 和 offset 拼接分片，
+// 检查多分片样本与 Topic 名称声明能还原、序号不变时不重发、max_hz 限制发送频率。
+// 运行：west build -b native_sim tests/lib/TopicMirror -t run
+
+#include <cstring>
+#include <utility>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/CommBridge/TopicMirror.hpp>
+#include <OF/lib/Node/Macro.hpp>
+
+LOG_MODULE_REGISTER(topic_mirror_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    // 40 字节，按 16 字节分片为 16 + 16 + 8
+    struct LargeData
+    {
+        uint32_t words[10];
+    };
+
+    struct SmallData
+    {
+        uint32_t value;
+    };
+
+    constexpr uint32_t SLOW_HZ = 10;
+}
+
+ONE_TOPIC_REGISTER(LargeData, topic_mirror_large, "mirror_large_sample");
+ONE_TOPIC_REGISTER(SmallData, topic_mirror_slow, "mirror_slow");
+
+namespace
+{
+    // 一个拼接完整的样本或 Topic 声明
+    struct Received
+    {
+        uint16_t topic;
+        uint32_t seq;
+        uint16_t total;
+        uint8_t data[CONFIG_COMM_BRIDGE_TOPIC_MIRROR_MAX_SAMPLE];
+    };
+
+    // 代替 CommBridge：按上位机的方式拼接分片，串口上的包按发送顺序到达
+    struct FakeBridge
+    {
+        Received pending{};
+        uint16_t pending_len{0};
+        Received done[16]{};
+        size_t done_cnt{0};
+        size_t packets{0};
+        bool bad_chunk{false};
+
+        void send(const TopicMirrorPacket& packet)
+        {
+            ++packets;
+            if (packet.offset == 0)
+            {
+                pending.topic = packet.topic;
+                pending.seq = packet.seq;
+                pending.total = packet.total;
+                pending_len = 0;
+            }
+            if (packet.topic != pending.topic || packet.seq != pending.seq || packet.offset != pending_len
+                || packet.len > sizeof(packet.payload) || pending_len + packet.len > packet.total)
+            {
+                bad_chunk = true;
+                return;
+            }
+
+            std::memcpy(&pending.data[packet.offset], packet.payload, packet.len);
+            pending_len += packet.len;
+            if (pending_len == packet.total && done_cnt < std::size(done))
+            {
+                done[done_cnt++] = pending;
+            }
+        }
+
+        // 取出并清空已拼接完整的样本
+        size_t take()
+        {
+            return std::exchange(done_cnt, 0);
+        }
+    };
+
+    FakeBridge g_bridge;
+
+    constexpr MirrorEntry ENTRIES[] = {
+        {"mirror_large_sample", 0},
+        {"mirror_slow", SLOW_HZ},
+    };
+
+    uint16_t topic_id(const char* name)
+    {
+        return static_cast<uint16_t>(find_topic(name) - all_topics().data());
+    }
+
+    bool is_announce(const Received& received, const char* name)
+    {
+        return received.seq == 0 && received.topic == topic_id(name) && received.total == strlen(name)
+            && std::memcmp(received.data, name, received.total) == 0;
+    }
+
+    LargeData make_large(const uint32_t base)
+    {
+        LargeData data{};
+        for (uint32_t i = 0; i < std::size(data.words); ++i)
+        {
+            data.words[i] = base * 0x9E3779B9u + i;
+        }
+        return data;
+    }
+
+    bool check_announce(TopicMirror<FakeBridge>& mirror)
+    {
+        // 构造后第一次 poll() 先发送所有 Topic 的声明，名称长于分片时同样分片发送
+        mirror.poll();
+        const size_t cnt = g_bridge.take();
+        if (cnt != 2 || !is_announce(g_bridge.done[0], "mirror_large_sample")
+            || !is_announce(g_bridge.done[1], "mirror_slow"))
+        {
+            LOG_ERR("announce: %u complete packets", static_cast<unsigned>(cnt));
+            return false;
+        }
+        return true;
+    }
+
+    bool check_chunks(TopicMirror<FakeBridge>& mirror)
+    {
+        const LargeData sent = make_large(7);
+        const uint32_t seq = topic_mirror_large.write(sent);
+
+        const size_t packets = g_bridge.packets;
+        if (mirror.poll() != 1 || g_bridge.take() != 1)
+        {
+            LOG_ERR("large sample was not mirrored");
+            return false;
+        }
+        const Received& received = g_bridge.done[0];
+        constexpr size_t chunks = (sizeof(LargeData) + CONFIG_COMM_BRIDGE_TOPIC_MIRROR_CHUNK - 1)
+            / CONFIG_COMM_BRIDGE_TOPIC_MIRROR_CHUNK;
+        if (g_bridge.packets - packets != chunks || received.topic != topic_id("mirror_large_sample")
+            || received.seq != seq || received.total != sizeof(LargeData)
+            || std::memcmp(received.data, &sent, sizeof(LargeData)) != 0)
+        {
+            LOG_ERR("reassembled sample differs: %u packets, seq %u",
+                    static_cast<unsigned>(g_bridge.packets - packets), received.seq);
+            return false;
+        }
+
+        // 序号未变化时不重发
+        if (mirror.poll() != 0 || g_bridge.packets != packets + chunks)
+        {
+            LOG_ERR("unchanged sample was resent");
+            return false;
+        }
+        return true;
+    }
+
+    bool check_max_hz(TopicMirror<FakeBridge>& mirror)
+    {
+        topic_mirror_slow.write({1});
+        if (mirror.poll() != 1 || g_bridge.take() != 1 || g_bridge.done[0].seq != topic_mirror_slow.generation())
+        {
+            LOG_ERR("first slow sample was not mirrored");
+            return false;
+        }
+
+        // 频率上限对应的周期内不再发送，周期过后发送最新的样本
+        topic_mirror_slow.write({2});
+        topic_mirror_slow.write({3});
+        if (mirror.poll() != 0)
+        {
+            LOG_ERR("slow topic mirrored faster than %u Hz", SLOW_HZ);
+            return false;
+        }
+        k_msleep(1000 / SLOW_HZ + 10);
+        if (mirror.poll() != 1 || g_bridge.take() != 1)
+        {
+            LOG_ERR("slow topic was not mirrored after its period");
+            return false;
+        }
+        uint32_t value{};
+        std::memcpy(&value, g_bridge.done[0].data, sizeof(value));
+        if (value != 3 || g_bridge.done[0].seq != topic_mirror_slow.generation())
+        {
+            LOG_ERR("slow topic mirrored value %u, expected the latest", value);
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    TopicMirror<FakeBridge> mirror(g_bridge, ENTRIES);
+
+    bool pass = check_announce(mirror);
+    pass &= check_chunks(mirror);
+    pass &= check_max_hz(mirror);
+    pass &= !g_bridge.bad_chunk;
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
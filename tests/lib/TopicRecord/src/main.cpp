@@ -0,0 +1,186 @@
+// Topic 录制与回放往返测试。
+// 录制：rec_queue 通过 write()、rec_inplace 通过 manipulate() 交替发布 COUNT 次，导出后按 OFREC 行打印，
+// 再在固件内回放导出内容，检查两个 Topic 收到的样本与录制时一致。
+//   west build -b native_sim tests/lib/TopicRecord -t run | tee record.log
+// 经 scripts/topic_record.py 还原导出文件，并以 CONFIG_NODE_REPLAY_FILE 编译进固件启动后回放，同样检查收到的样本：
+//   python3 scripts/topic_record.py extract record.log match.bin
+//   python3 scripts/topic_record.py show match.bin
+//   west build -p -b native_sim tests/lib/TopicRecord -t run -- -DCONFIG_NODE_REPLAY_FILE=\"$PWD/match.bin\"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/Node/Macro.hpp>
+#include <OF/lib/Node/NodeManager.hpp>
+#include <OF/lib/Node/Recorder.hpp>
+
+LOG_MODULE_REGISTER(topic_record_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    struct RecordData
+    {
+        uint32_t index;
+        float value;
+    };
+
+    // 不超过 CONFIG_TOPIC_QUEUE_N，回放后一次取出 rec_queue 的全部样本
+    constexpr uint32_t COUNT = 12;
+    constexpr size_t DUMP_LINE_BYTES = 32;
+    constexpr bool FROM_FILE = sizeof(CONFIG_NODE_REPLAY_FILE) > 1;
+
+    RecordData make(const uint32_t index)
+    {
+        return {index, static_cast<float>(index) * 0.5f};
+    }
+}
+
+ONE_QUEUED_TOPIC_REGISTER(RecordData, topic_rec_queue, "rec_queue");
+ONE_TOPIC_REGISTER(RecordData, topic_rec_inplace, "rec_inplace");
+
+namespace
+{
+    // 导出内容保存一份供固件内回放，同时按 topic record dump 的格式逐行打印
+    struct Capture
+    {
+        uint8_t bytes[1024];
+        size_t len;
+        bool overflow;
+        uint8_t line[DUMP_LINE_BYTES];
+        size_t line_len;
+
+        void flush()
+        {
+            char hex[DUMP_LINE_BYTES * 2 + 1];
+            for (size_t i = 0; i < line_len; ++i)
+            {
+                snprintk(&hex[i * 2], 3, "%02x", line[i]);
+            }
+            hex[line_len * 2] = '\0';
+            printk("OFREC:%s\n", hex);
+            line_len = 0;
+        }
+    };
+
+    Capture g_capture;
+
+    void capture_sink(const uint8_t* data, const size_t len, void* user_data)
+    {
+        auto* capture = static_cast<Capture*>(user_data);
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (capture->len < sizeof(capture->bytes))
+            {
+                capture->bytes[capture->len++] = data[i];
+            }
+            else
+            {
+                capture->overflow = true;
+            }
+            capture->line[capture->line_len++] = data[i];
+            if (capture->line_len == DUMP_LINE_BYTES)
+            {
+                capture->flush();
+            }
+        }
+    }
+
+    // 回放后 rec_queue 中依次是 1 ~ COUNT，rec_inplace 恰好发布了 COUNT 次且最新样本为 COUNT
+    bool check_replayed(QueuedTopic<RecordData>::Cursor& cursor, const uint32_t inplace_gen)
+    {
+        uint32_t expect = 1;
+        bool match = true;
+        const auto result = topic_rec_queue.poll(cursor, [&expect, &match](const RecordData& data)
+        {
+            const RecordData want = make(expect++);
+            match &= data.index == want.index && data.value == want.value;
+        });
+        if (!match || result.received != COUNT || result.dropped != 0)
+        {
+            LOG_ERR("rec_queue: received %u, dropped %u, match %d", result.received, result.dropped, match);
+            return false;
+        }
+
+        const RecordData last = topic_rec_inplace.read();
+        const uint32_t publishes = topic_rec_inplace.generation() - inplace_gen;
+        if (publishes != COUNT || last.index != COUNT || last.value != make(COUNT).value)
+        {
+            LOG_ERR("rec_inplace: %u publishes, last index %u", publishes, last.index);
+            return false;
+        }
+        return true;
+    }
+
+    bool record_and_replay()
+    {
+        recorder_select(*find_topic("rec_queue"), true);
+        recorder_select(*find_topic("rec_inplace"), true);
+        recorder_clear();
+        recorder_start();
+        for (uint32_t i = 1; i <= COUNT; ++i)
+        {
+            topic_rec_queue.write(make(i));
+            topic_rec_inplace.manipulate([i](RecordData& data) { data = make(i); });
+        }
+        recorder_stop();
+
+        const RecorderStatus status = recorder_status();
+        if (status.records != 2 * COUNT || status.overwritten != 0)
+        {
+            LOG_ERR("recorded %u records, %u overwritten", status.records, status.overwritten);
+            return false;
+        }
+
+        if (recorder_dump(capture_sink, &g_capture) != 0 || g_capture.overflow)
+        {
+            LOG_ERR("dump failed");
+            return false;
+        }
+        if (g_capture.line_len != 0)
+        {
+            g_capture.flush();
+        }
+        printk("OFREC:END\n");
+
+        auto cursor = topic_rec_queue.subscribe();
+        const uint32_t inplace_gen = topic_rec_inplace.generation();
+        const int replayed = recorder_replay({g_capture.bytes, g_capture.len}, ReplaySpeed::AsFastAsPossible);
+        if (replayed != static_cast<int>(2 * COUNT))
+        {
+            LOG_ERR("replayed %d records", replayed);
+            return false;
+        }
+        return check_replayed(cursor, inplace_gen);
+    }
+
+    // 导出文件由 Replay.cpp 的回放线程在启动 CONFIG_NODE_REPLAY_DELAY_MS 毫秒后发布
+    bool replay_from_file()
+    {
+        auto cursor = topic_rec_queue.subscribe();
+        const uint32_t inplace_gen = topic_rec_inplace.generation();
+        for (int i = 0; i < CONFIG_NODE_REPLAY_DELAY_MS / 10 + 100; ++i)
+        {
+            if (topic_rec_inplace.generation() - inplace_gen == COUNT)
+            {
+                break;
+            }
+            k_msleep(10);
+        }
+        return check_replayed(cursor, inplace_gen);
+    }
+}
+
+int main()
+{
+    const bool pass = FROM_FILE ? replay_from_file() : record_and_replay();
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
@@ -0,0 +1,142 @@
+// wait_any 测试：同时等待 Topic、Subscriber、QueuedTopic 与 LoanedTopic，
+// 由另一个线程延时向其中一个发布，检查 wait_any() 被唤醒且只报告该来源；
+// 另外检查已有未读发布时立即返回、没有发布时超时返回全 0。
+// 运行：west build -b native_sim tests/lib/WaitAny -t run
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/Node/Macro.hpp>
+#include <OF/lib/Node/WaitAny.hpp>
+
+LOG_MODULE_REGISTER(wait_any_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    struct WaitData
+    {
+        uint32_t value;
+    };
+}
+
+ONE_TOPIC_REGISTER(WaitData, topic_wait_plain, "wait_plain");
+ONE_TOPIC_REGISTER(WaitData, topic_wait_sub, "wait_sub");
+ONE_QUEUED_TOPIC_REGISTER(WaitData, topic_wait_queued, "wait_queued");
+ONE_LOANED_TOPIC_REGISTER(WaitData, topic_wait_loaned, "wait_loaned", 3);
+
+namespace
+{
+    // wait_any() 参数中的下标
+    enum Source : uint32_t
+    {
+        PLAIN,
+        SUB,
+        QUEUED,
+        LOANED,
+        SOURCE_CNT,
+    };
+
+    constexpr const char* SOURCE_NAMES[SOURCE_CNT] = {"Topic", "Subscriber", "QueuedTopic", "LoanedTopic"};
+    constexpr int32_t PUBLISH_DELAY_MS = 20;
+    constexpr size_t STACK_SIZE = 1024;
+
+    K_THREAD_STACK_DEFINE(publisher_stack, STACK_SIZE);
+    k_thread publisher_thread;
+
+    void publish(const Source source)
+    {
+        switch (source)
+        {
+        case PLAIN:
+            topic_wait_plain.write({1});
+            break;
+        case SUB:
+            topic_wait_sub.write({2});
+            break;
+        case QUEUED:
+            topic_wait_queued.write({3});
+            break;
+        case LOANED:
+            if (Loan<WaitData> loan = topic_wait_loaned.loan())
+            {
+                loan->value = 4;
+                topic_wait_loaned.publish(std::move(loan));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void publisher_entry(void* p1, void*, void*)
+    {
+        publish(static_cast<Source>(reinterpret_cast<uintptr_t>(p1)));
+    }
+
+    bool check_wakeup(Subscriber<WaitData>& sub, const Source source)
+    {
+        // 低优先级线程延时发布，发布之前 wait_any() 已经挂起
+        k_thread_create(&publisher_thread, publisher_stack, STACK_SIZE, publisher_entry,
+                        reinterpret_cast<void*>(source), nullptr, nullptr, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+                        K_MSEC(PUBLISH_DELAY_MS));
+
+        const int64_t start = k_uptime_get();
+        const auto ready = wait_any(K_MSEC(1000), topic_wait_plain, sub, topic_wait_queued, topic_wait_loaned);
+        const int64_t elapsed = k_uptime_get() - start;
+        k_thread_join(&publisher_thread, K_FOREVER);
+
+        if (ready.to_ulong() != (1UL << source) || elapsed < PUBLISH_DELAY_MS / 2 || elapsed >= 1000)
+        {
+            LOG_ERR("%s: ready 0x%lx after %lld ms", SOURCE_NAMES[source], ready.to_ulong(), elapsed);
+            return false;
+        }
+
+        // Subscriber 的发布读走之后才不再报告为新
+        if (source == SUB && !sub.read_if_new())
+        {
+            LOG_ERR("Subscriber has nothing to read");
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    auto sub = topic_wait_sub.subscribe();
+    bool pass = true;
+
+    for (uint32_t source = 0; source < SOURCE_CNT; ++source)
+    {
+        pass &= check_wakeup(sub, static_cast<Source>(source));
+    }
+
+    // 没有新发布时超时返回全 0
+    const auto none = wait_any(K_MSEC(PUBLISH_DELAY_MS), topic_wait_plain, sub, topic_wait_queued,
+                               topic_wait_loaned);
+    if (none.any())
+    {
+        LOG_ERR("timeout reported ready 0x%lx", none.to_ulong());
+        pass = false;
+    }
+
+    // Subscriber 在调用之前已有未读发布时不等待
+    topic_wait_sub.write({5});
+    const int64_t start = k_uptime_get();
+    const auto pending = wait_any(K_MSEC(1000), topic_wait_plain, sub);
+    if (pending.to_ulong() != 0b10 || k_uptime_get() - start >= PUBLISH_DELAY_MS)
+    {
+        LOG_ERR("pending Subscriber publish not reported immediately");
+        pass = false;
+    }
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
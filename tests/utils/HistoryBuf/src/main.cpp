@@ -0,0 +1,176 @@
+// HistoryBuf 测试：先检查插值与边界（含递减的无符号整数），再让写者线程从时间戳即将回绕处开始持续写入，
+// 读者回溯写者刚写过的时刻，插值结果等于该时刻的期望值才算读到一致的样本。
+// 多核运行：west build -b qemu_x86_64 tests/utils/HistoryBuf -t run
+// 单核平台（如 native_sim）上同样可以运行，此时只验证写者抢占读者时的正确性。
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/utils/HistoryBuf.hpp>
+
+LOG_MODULE_REGISTER(history_buf_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    constexpr size_t STACK_SIZE = 1024;
+    constexpr int32_t RUN_TIME_MS = 1000;
+    constexpr uint32_t STEP = 4;
+    constexpr uint32_t LOOKBACK = 41; // 不在采样点上，需要插值
+    constexpr uint32_t BASE = UINT32_MAX - 1000 * STEP; // 时间戳 = BASE + 值，运行中会回绕
+
+    // 写者优先级更高：读者在写入途中让出 CPU，若读者优先级更高，单核上会一直等待被它抢占的写者
+    constexpr int WRITER_PRIORITY = 3;
+    constexpr int READER_PRIORITY = 6;
+
+    // 值随时间线性增长，任何时刻的插值结果都应等于 时刻 - BASE
+    HistoryBuf<double, 32> g_history;
+    atomic_t g_last_value = ATOMIC_INIT(0);
+
+    atomic_t g_running = ATOMIC_INIT(1);
+    atomic_t g_reads = ATOMIC_INIT(0);
+    atomic_t g_bad = ATOMIC_INIT(0);
+
+    K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+    K_THREAD_STACK_DEFINE(reader_stack, STACK_SIZE);
+    k_thread writer_thread;
+    k_thread reader_thread;
+
+    void writer_entry(void*, void*, void*)
+    {
+        uint32_t value{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 64; ++burst)
+            {
+                value += STEP;
+                g_history.push(BASE + value, value);
+                atomic_set(&g_last_value, static_cast<atomic_val_t>(value));
+            }
+            k_usleep(100);
+        }
+    }
+
+    void reader_entry(void*, void*, void*)
+    {
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 64; ++burst)
+            {
+                const auto last = static_cast<uint32_t>(atomic_get(&g_last_value));
+                if (last < LOOKBACK)
+                {
+                    continue;
+                }
+                const uint32_t expected = last - LOOKBACK;
+                if (const auto val = g_history.sample_at(BASE + expected))
+                {
+                    if (static_cast<uint32_t>(*val) != expected)
+                    {
+                        atomic_inc(&g_bad);
+                    }
+                    atomic_inc(&g_reads);
+                }
+            }
+            k_usleep(70);
+        }
+    }
+
+    // 线程创建后暂不启动，固定到 cpu 后再运行；未开启 CPU 掩码时由调度器自由分配
+    void spawn(k_thread& thread, k_thread_stack_t* stack, const k_thread_entry_t entry, const int priority,
+               const int cpu)
+    {
+        k_thread_create(&thread, stack, STACK_SIZE, entry, nullptr, nullptr, nullptr, priority, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+        k_thread_cpu_pin(&thread, cpu);
+#else
+        ARG_UNUSED(cpu);
+#endif
+        k_thread_start(&thread);
+    }
+
+    bool check_basic()
+    {
+        HistoryBuf<float, 4> history;
+        if (history.sample_at(0))
+        {
+            LOG_ERR("FAIL: empty history returned a sample");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < 6; ++i)
+        {
+            history.push(100 + i * 10, static_cast<float>(i));
+        }
+        // 保留 i = 2..5，即时刻 120..150
+        const auto mid = history.sample_at(125);
+        const auto newer = history.sample_at(1000);
+        if (!mid || *mid != 2.5f || !newer || *newer != 5.0f || history.sample_at(119))
+        {
+            LOG_ERR("FAIL: interpolation or bounds");
+            return false;
+        }
+        return true;
+    }
+
+    // 无符号数递减时插值结果仍介于两个样本之间，不能回绕成接近 2^32 的值
+    bool check_unsigned()
+    {
+        HistoryBuf<uint32_t, 4> down;
+        down.push(100, 10);
+        down.push(110, 5);
+        HistoryBuf<uint64_t, 4> down64;
+        down64.push(100, 1000);
+        down64.push(110, 0);
+        HistoryBuf<int16_t, 4> signed_down;
+        signed_down.push(100, 4);
+        signed_down.push(110, -4);
+
+        const auto val = down.sample_at(105);
+        const auto val64 = down64.sample_at(103);
+        const auto val_signed = signed_down.sample_at(105);
+        if (!val || *val != 8 || !val64 || *val64 != 700 || !val_signed || *val_signed != 0)
+        {
+            LOG_ERR("FAIL: decreasing integer interpolation: %u, %u, %d", val ? *val : 0,
+                    val64 ? static_cast<uint32_t>(*val64) : 0, val_signed ? *val_signed : 0);
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    if (!check_basic() || !check_unsigned())
+    {
+        return -1;
+    }
+
+    // 多核时读写线程固定在不同核心上，查找与写入真正并发；单核时写者频繁抢占正在查找的读者
+    const unsigned int cpus = arch_num_cpus();
+    LOG_INF("HistoryBuf stress: %u CPUs, %d ms", cpus, RUN_TIME_MS);
+    spawn(writer_thread, writer_stack, writer_entry, WRITER_PRIORITY, 0);
+    spawn(reader_thread, reader_stack, reader_entry, READER_PRIORITY, static_cast<int>(1 % cpus));
+
+    k_msleep(RUN_TIME_MS);
+    atomic_clear(&g_running);
+    k_thread_join(&writer_thread, K_FOREVER);
+    k_thread_join(&reader_thread, K_FOREVER);
+
+    const auto bad = atomic_get(&g_bad);
+    LOG_INF("reads: %ld, inconsistent: %ld", atomic_get(&g_reads), bad);
+    if constexpr (BufStats::enabled)
+    {
+        const auto stats = g_history.stats();
+        LOG_INF("retries: %u, yields: %u, max read: %u cyc", stats.retries, stats.yields, stats.max_read_cyc);
+    }
+
+    if (bad != 0)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
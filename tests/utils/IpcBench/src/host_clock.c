@@ -0,0 +1,14 @@
+/*
+ * native_sim 上代码执行不推进仿真时间，k_cycle_get_32() 测不出操作耗时，
+ * 该文件编译进宿主机侧运行器，直接读取宿主机单调时钟。
+ */
+
+#include <stdint.h>
+#include <time.h>
+
+uint64_t ipc_bench_host_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,29 @@
+#ifndef OF_UTILS_IPC_BENCH_PAYLOAD_H
+#define OF_UTILS_IPC_BENCH_PAYLOAD_H
+
+#include <stdint.h>
+
+#include <zephyr/zbus/zbus.h>
+
+// 参与测试的载荷字节数，main.cpp 与 zbus_channels.c 共用
+#define IPC_BENCH_PAYLOAD_SIZES(X) X(4) X(64) X(256) X(1024)
+
+// 每种载荷一个 zbus 通道；通道在 C 文件中定义，避免 ZBUS_CHAN_DEFINE 的指定初始化器在 C++ 中受限
+#define IPC_BENCH_PAYLOAD_DECLARE(Size) \
+    struct ipc_payload_##Size \
+    { \
+        uint8_t bytes[Size]; \
+    }; \
+    ZBUS_CHAN_DECLARE(ipc_chan_##Size);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+IPC_BENCH_PAYLOAD_SIZES(IPC_BENCH_PAYLOAD_DECLARE)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //OF_UTILS_IPC_BENCH_PAYLOAD_H
@@ -0,0 +1,7 @@
+#include "payload.h"
+
+#define IPC_BENCH_CHAN_DEFINE(Size) \
+    ZBUS_CHAN_DEFINE(ipc_chan_##Size, struct ipc_payload_##Size, NULL, NULL, ZBUS_OBSERVERS_EMPTY, \
+                     ZBUS_MSG_INIT(0));
+
+IPC_BENCH_PAYLOAD_SIZES(IPC_BENCH_CHAN_DEFINE)
@@ -0,0 +1,222 @@
+// NBuf 多写者压力测试：不同优先级的写者线程并发发布，读者检查撕裂读与序号回退；
+// 读者按写者记录看到的计数与序号，两者必须同向增长且不超过写者最后一次发布的序号；
+// 结束时最新样本必须是序号最大的那次发布。
+// 写者同时用 update_at() 各自更新数组中的一个元素，结束时检查没有元素被其他写者的发布覆盖。
+// 建议在 native_sim 上运行：west build -b native_sim tests/utils/NBuf -t run
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/utils/NBuf.hpp>
+
+#include "TornPayload.hpp"
+
+LOG_MODULE_REGISTER(nbuf_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    constexpr size_t WRITER_CNT = 4;
+    constexpr size_t READER_CNT = 2;
+    constexpr size_t STACK_SIZE = 1024;
+    constexpr int32_t RUN_TIME_MS = 2000;
+
+    using Payload = test::TornPayload<14>;
+    using test::check_word;
+
+    NBuf<Payload, 8, WriterPolicy::Multi> g_buf;
+    NBuf<std::array<uint32_t, WRITER_CNT>, 8, WriterPolicy::Multi> g_elems;
+    uint32_t g_last_counter[WRITER_CNT];
+    uint32_t g_last_seq[WRITER_CNT];
+
+    // 每个读者看到的每个写者最新的一次发布
+    struct Seen
+    {
+        uint32_t counter;
+        uint32_t seq;
+    };
+
+    Seen g_seen[READER_CNT][WRITER_CNT];
+
+    atomic_t g_running = ATOMIC_INIT(1);
+    atomic_t g_writes = ATOMIC_INIT(0);
+    atomic_t g_reads = ATOMIC_INIT(0);
+    atomic_t g_torn = ATOMIC_INIT(0);
+    atomic_t g_seq_regress = ATOMIC_INIT(0);
+    atomic_t g_seq_mismatch = ATOMIC_INIT(0);
+
+    bool is_newer(const uint32_t a, const uint32_t b)
+    {
+        return static_cast<int32_t>(a - b) > 0;
+    }
+
+    K_THREAD_STACK_ARRAY_DEFINE(writer_stacks, WRITER_CNT, STACK_SIZE);
+    K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, READER_CNT, STACK_SIZE);
+    k_thread writer_threads[WRITER_CNT];
+    k_thread reader_threads[READER_CNT];
+
+    void writer_entry(void* p1, void*, void*)
+    {
+        const auto writer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p1));
+        uint32_t counter{}, seq{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 64; ++burst)
+            {
+                ++counter;
+                seq = g_buf.manipulate([writer, counter](Payload& data)
+                {
+                    data.writer = writer;
+                    data.counter = counter;
+                    for (size_t i = 0; i < std::size(data.check); ++i)
+                    {
+                        data.check[i] = check_word(writer, counter, i);
+                        // 拉长写入窗口，让高优先级线程的定时唤醒更容易落在写入途中
+                        if (i == std::size(data.check) / 2)
+                        {
+                            k_busy_wait(1);
+                        }
+                    }
+                });
+                atomic_inc(&g_writes);
+                g_elems.update_at(writer - 1, counter);
+            }
+            // 各写者睡眠周期互不相同，唤醒时刻与其他线程的写入交错
+            k_usleep(static_cast<int32_t>(100 + writer * 37));
+        }
+        g_last_counter[writer - 1] = counter;
+        g_last_seq[writer - 1] = seq;
+    }
+
+    void reader_entry(void* p1, void*, void*)
+    {
+        const auto reader = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p1));
+        uint32_t last_seq{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 64; ++burst)
+            {
+                const auto [data, seq, stamp] = g_buf.read_with_meta();
+                ARG_UNUSED(stamp);
+                if (test::is_torn(data))
+                {
+                    atomic_inc(&g_torn);
+                }
+                if (is_newer(last_seq, seq))
+                {
+                    atomic_inc(&g_seq_regress);
+                }
+                last_seq = seq;
+
+                // 同一写者的发布，计数更新的样本序号也必须更新
+                if (data.writer >= 1 && data.writer <= WRITER_CNT)
+                {
+                    auto& seen = g_seen[reader - 1][data.writer - 1];
+                    if (data.counter != seen.counter && is_newer(data.counter, seen.counter) != is_newer(seq, seen.seq))
+                    {
+                        atomic_inc(&g_seq_mismatch);
+                    }
+                    if (is_newer(data.counter, seen.counter))
+                    {
+                        seen = {data.counter, seq};
+                    }
+                }
+                atomic_inc(&g_reads);
+            }
+            k_usleep(static_cast<int32_t>(50 + reader * 29));
+        }
+    }
+}
+
+int main()
+{
+    LOG_INF("NBuf multi-writer stress: %u writers, %u readers, %d ms", static_cast<unsigned>(WRITER_CNT), static_cast<unsigned>(READER_CNT), RUN_TIME_MS);
+
+    for (size_t i = 0; i < WRITER_CNT; ++i)
+    {
+        // 写者优先级 2, 4, 6, 8：高优先级写者会抢占正在写槽位的低优先级写者
+        k_thread_create(&writer_threads[i], writer_stacks[i], STACK_SIZE, writer_entry,
+                        reinterpret_cast<void*>(i + 1), nullptr, nullptr,
+                        static_cast<int>(2 + 2 * i), 0, K_NO_WAIT);
+    }
+    for (size_t i = 0; i < READER_CNT; ++i)
+    {
+        k_thread_create(&reader_threads[i], reader_stacks[i], STACK_SIZE, reader_entry,
+                        reinterpret_cast<void*>(i + 1), nullptr, nullptr,
+                        static_cast<int>(3 + 4 * i), 0, K_NO_WAIT);
+    }
+
+    k_msleep(RUN_TIME_MS);
+    atomic_clear(&g_running);
+    for (auto& thread : writer_threads)
+    {
+        k_thread_join(&thread, K_FOREVER);
+    }
+    for (auto& thread : reader_threads)
+    {
+        k_thread_join(&thread, K_FOREVER);
+    }
+
+    const auto writes = atomic_get(&g_writes);
+    const auto torn = atomic_get(&g_torn);
+    const auto regress = atomic_get(&g_seq_regress);
+    const auto mismatch = atomic_get(&g_seq_mismatch);
+    LOG_INF("writes: %ld, reads: %ld, generation: %u", writes, atomic_get(&g_reads), g_buf.generation());
+    if constexpr (BufStats::enabled)
+    {
+        const auto stats = g_buf.stats();
+        LOG_INF("retries: %u, yields: %u, max read: %u cyc", stats.retries, stats.yields, stats.max_read_cyc);
+    }
+
+    if (torn != 0 || regress != 0 || mismatch != 0)
+    {
+        LOG_ERR("FAIL: torn reads %ld, seq regressions %ld, seq/counter mismatches %ld", torn, regress, mismatch);
+        return -1;
+    }
+
+    // 读者看到的发布不能晚于写者最后一次发布
+    size_t newest{};
+    for (size_t w = 0; w < WRITER_CNT; ++w)
+    {
+        for (size_t r = 0; r < READER_CNT; ++r)
+        {
+            const auto& seen = g_seen[r][w];
+            if (is_newer(seen.counter, g_last_counter[w]) || is_newer(seen.seq, g_last_seq[w]))
+            {
+                LOG_ERR("FAIL: reader %u saw writer %u at counter %u seq %u, last publish counter %u seq %u",
+                        static_cast<unsigned>(r + 1), static_cast<unsigned>(w + 1), seen.counter, seen.seq,
+                        g_last_counter[w], g_last_seq[w]);
+                return -1;
+            }
+        }
+        if (is_newer(g_last_seq[w], g_last_seq[newest]))
+        {
+            newest = w;
+        }
+    }
+
+    // 所有写者退出后，最新样本必须是序号最大的那次发布
+    const auto [latest, latest_seq, latest_stamp] = g_buf.read_with_meta();
+    ARG_UNUSED(latest_stamp);
+    if (latest_seq != g_last_seq[newest] || latest.writer != newest + 1 || latest.counter != g_last_counter[newest]
+        || g_buf.generation() != latest_seq)
+    {
+        LOG_ERR("FAIL: latest is writer %u counter %u seq %u, expected writer %u counter %u seq %u",
+                latest.writer, latest.counter, latest_seq, static_cast<unsigned>(newest + 1),
+                g_last_counter[newest], g_last_seq[newest]);
+        return -1;
+    }
+
+    const auto elems = g_elems.read();
+    for (size_t i = 0; i < WRITER_CNT; ++i)
+    {
+        if (elems[i] != g_last_counter[i])
+        {
+            LOG_ERR("FAIL: element %u is %u, last update %u", static_cast<unsigned>(i), elems[i], g_last_counter[i]);
+            return -1;
+        }
+    }
+    LOG_INF("PASS");
+    return 0;
+}
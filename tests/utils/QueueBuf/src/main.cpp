@@ -0,0 +1,217 @@
+// QueueBuf 测试：先单线程检查 poll() 的交付顺序、max 限制与落后超过 N 条时的丢失计数，
+// 再让一个写者持续写入，不同优先级、不同轮询间隔的读者检查撕裂读、乱序，
+// 以及结束时每个读者交付与丢失的样本数之和等于写入总数。
+// 建议在 native_sim 上运行：west build -b native_sim tests/utils/QueueBuf -t run
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/utils/QueueBuf.hpp>
+
+LOG_MODULE_REGISTER(queue_buf_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    constexpr size_t N = 8;
+    constexpr size_t READER_CNT = 3;
+    constexpr size_t STACK_SIZE = 1024;
+    constexpr int32_t RUN_TIME_MS = 2000;
+
+    constexpr int WRITER_PRIORITY = 4;
+    constexpr int READER_PRIORITIES[READER_CNT] = {3, 5, 6};
+    // 轮询间隔依次变长，最慢的读者经常落后超过 N 条
+    constexpr int32_t READER_SLEEP_US[READER_CNT] = {50, 200, 1000};
+
+    // 每个字都由 counter 推导，读到混合两次写入的数据即可被发现；单写者的 counter 即发布序号
+    struct Payload
+    {
+        uint32_t counter;
+        uint32_t check[15];
+    };
+
+    constexpr uint32_t check_word(const uint32_t counter, const size_t i)
+    {
+        return (counter * 0x85EBCA6Bu) ^ static_cast<uint32_t>(i);
+    }
+
+    Payload make(const uint32_t counter)
+    {
+        Payload data{counter, {}};
+        for (size_t i = 0; i < std::size(data.check); ++i)
+        {
+            data.check[i] = check_word(counter, i);
+        }
+        return data;
+    }
+
+    bool is_torn(const Payload& data)
+    {
+        for (size_t i = 0; i < std::size(data.check); ++i)
+        {
+            if (data.check[i] != check_word(data.counter, i))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ---------------------------------------------------------------- 单线程检查
+
+    bool check_poll()
+    {
+        QueueBuf<Payload, N> buf;
+        auto early = buf.subscribe();
+
+        for (uint32_t i = 1; i <= 3; ++i)
+        {
+            buf.write(make(i));
+        }
+        auto late = buf.subscribe();
+        if (buf.has_new(late) || !buf.has_new(early))
+        {
+            LOG_ERR("has_new after subscribe");
+            return false;
+        }
+
+        // 按发布顺序交付，max 限制单次交付数
+        uint32_t expect = 1;
+        bool ordered = true;
+        auto in_order = [&expect, &ordered](const Payload& data) { ordered &= data.counter == expect++; };
+        auto r = buf.poll(early, in_order, 2);
+        r.received += buf.poll(early, in_order).received;
+        if (!ordered || r.received != 3 || r.dropped != 0 || buf.has_new(early))
+        {
+            LOG_ERR("poll order: received %u, dropped %u", r.received, r.dropped);
+            return false;
+        }
+
+        // 落后 N + 5 条：最旧的 5 条已被覆盖，其余 N 条仍按顺序交付
+        for (uint32_t i = 4; i < 4 + N + 5; ++i)
+        {
+            buf.write(make(i));
+        }
+        expect = 4 + 5;
+        r = buf.poll(early, in_order);
+        if (!ordered || r.received != N || r.dropped != 5 || early.dropped != 5)
+        {
+            LOG_ERR("poll overflow: received %u, dropped %u", r.received, r.dropped);
+            return false;
+        }
+
+        // latest() 不影响任何 Cursor
+        if (buf.latest().counter != 3 + N + 5 || buf.latest_meta().seq != buf.head() || !buf.has_new(late))
+        {
+            LOG_ERR("latest");
+            return false;
+        }
+        return true;
+    }
+
+    // ---------------------------------------------------------------- 并发读写
+
+    QueueBuf<Payload, N> g_buf;
+
+    atomic_t g_running = ATOMIC_INIT(1);
+    atomic_t g_torn = ATOMIC_INIT(0);
+    atomic_t g_out_of_order = ATOMIC_INIT(0);
+    uint32_t g_received[READER_CNT];
+    uint32_t g_dropped[READER_CNT];
+
+    K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+    K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, READER_CNT, STACK_SIZE);
+    k_thread writer_thread;
+    k_thread reader_threads[READER_CNT];
+
+    void writer_entry(void*, void*, void*)
+    {
+        uint32_t counter{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 16; ++burst)
+            {
+                g_buf.write(make(++counter));
+            }
+            k_usleep(100);
+        }
+    }
+
+    // 交付时 cursor.next 即该样本的序号
+    void poll_once(decltype(g_buf)::Cursor& cursor, uint32_t& received)
+    {
+        received += g_buf.poll(cursor, [&cursor](const Payload& data)
+        {
+            if (is_torn(data))
+            {
+                atomic_inc(&g_torn);
+            }
+            if (data.counter != cursor.next)
+            {
+                atomic_inc(&g_out_of_order);
+            }
+        }).received;
+    }
+
+    void reader_entry(void* p1, void*, void*)
+    {
+        const auto reader = reinterpret_cast<uintptr_t>(p1);
+        auto cursor = g_buf.subscribe();
+        uint32_t received{};
+        while (atomic_get(&g_running))
+        {
+            poll_once(cursor, received);
+            k_usleep(READER_SLEEP_US[reader]);
+        }
+
+        // 写者已停止（主线程先 join 写者），取完剩余样本
+        k_msleep(10);
+        poll_once(cursor, received);
+        g_received[reader] = received;
+        g_dropped[reader] = cursor.dropped;
+    }
+}
+
+int main()
+{
+    bool pass = check_poll();
+
+    // 读者先订阅，从第一条样本开始接收
+    for (size_t i = 0; i < READER_CNT; ++i)
+    {
+        k_thread_create(&reader_threads[i], reader_stacks[i], STACK_SIZE, reader_entry,
+                        reinterpret_cast<void*>(i), nullptr, nullptr, READER_PRIORITIES[i], 0, K_NO_WAIT);
+    }
+    k_msleep(1);
+    k_thread_create(&writer_thread, writer_stack, STACK_SIZE, writer_entry, nullptr, nullptr, nullptr,
+                    WRITER_PRIORITY, 0, K_NO_WAIT);
+
+    k_msleep(RUN_TIME_MS);
+    atomic_clear(&g_running);
+    k_thread_join(&writer_thread, K_FOREVER);
+    for (auto& thread : reader_threads)
+    {
+        k_thread_join(&thread, K_FOREVER);
+    }
+
+    const uint32_t writes = g_buf.head();
+    for (size_t i = 0; i < READER_CNT; ++i)
+    {
+        LOG_INF("reader %u: received %u, dropped %u of %u writes", static_cast<unsigned>(i), g_received[i],
+                g_dropped[i], writes);
+        pass &= g_received[i] + g_dropped[i] == writes;
+    }
+    const auto torn = atomic_get(&g_torn);
+    const auto out_of_order = atomic_get(&g_out_of_order);
+    LOG_INF("torn: %ld, out of order: %ld", torn, out_of_order);
+    pass &= torn == 0 && out_of_order == 0;
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
@@ -0,0 +1,316 @@
+// SeqlockBuf / NBuf / EpochGroup / LoanedTopic 多核压力测试：写者与读者固定在不同 CPU 上并发运行，检查撕裂读与序号回退。
+// 多核运行：west build -b qemu_x86_64 tests/utils/SmpStress -t run
+// 单核平台上同样可以运行，此时只验证抢占下的正确性。
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <OF/lib/Node/LoanedTopic.hpp>
+#include <OF/utils/EpochGroup.hpp>
+#include <OF/utils/NBuf.hpp>
+#include <OF/utils/SeqlockBuf.hpp>
+
+#include "TornPayload.hpp"
+
+LOG_MODULE_REGISTER(smp_stress_test, CONFIG_LOG_DEFAULT_LEVEL);
+
+using namespace OF;
+
+namespace
+{
+    constexpr size_t MAX_WRITER_CNT = 2;
+    constexpr size_t READER_CNT = 2;
+    constexpr size_t STACK_SIZE = 1024;
+    constexpr int32_t RUN_TIME_MS = 2000;
+    constexpr int PRIORITY = 5;
+
+    using Payload = test::TornPayload<30>;
+    using test::fill;
+    using test::is_torn;
+
+    SeqlockBuf<Payload> g_seqlock;
+    // 深度取最小值，写者最频繁地覆盖读者正在读的槽位
+    NBuf<Payload, 2> g_nbuf;
+    NBuf<Payload, 4, WriterPolicy::Multi> g_nbuf_multi;
+    NBuf<Payload, 4> g_group_a;
+    NBuf<Payload, 4> g_group_b;
+    EpochGroup g_group(g_group_a, g_group_b);
+    NBuf<Payload, 4> g_outside_a;
+    NBuf<Payload, 4> g_outside_b;
+    EpochGroup g_outside_group(g_outside_a, g_outside_b);
+    // Topic 持有 1 块，每个写者与读者各占 1 块，余下的块让写者偶尔借不到块
+    LoanedTopic<Payload, MAX_WRITER_CNT + READER_CNT + 2> g_loaned;
+
+    // 被测缓冲区：write 发布一次，read 读取一次并返回序号，0 表示没有读到数据
+    struct Target
+    {
+        const char* name;
+        size_t writer_cnt;
+        bool monotonic; // 读到的序号是否保证不回退
+        void (*write)(uint32_t writer, uint32_t counter);
+        uint32_t (*read)(Payload& out);
+    };
+
+    const Target targets[] = {
+        {
+            "SeqlockBuf", 1, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                auto func = [writer, counter](Payload& data) { fill(data, writer, counter); };
+                g_seqlock.manipulate(func);
+            },
+            [](Payload& out)
+            {
+                out = g_seqlock.read();
+                return out.counter;
+            },
+        },
+        {
+            "NBuf<Single>", 1, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                g_nbuf.manipulate([writer, counter](Payload& data) { fill(data, writer, counter); });
+            },
+            [](Payload& out) { return g_nbuf.read_into(out); },
+        },
+        {
+            "NBuf<Multi>", MAX_WRITER_CNT, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                g_nbuf_multi.manipulate([writer, counter](Payload& data) { fill(data, writer, counter); });
+            },
+            [](Payload& out) { return g_nbuf_multi.read_into(out); },
+        },
+        {
+            // 无等待读取会回退到更旧的槽位，序号可能回退，只检查撕裂
+            "NBuf<WaitFree>", MAX_WRITER_CNT, false,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                g_nbuf_multi.manipulate([writer, counter](Payload& data) { fill(data, writer, counter); });
+            },
+            [](Payload& out) { return g_nbuf_multi.read_into_wait_free(out); },
+        },
+        {
+            // 两个缓冲区在同一个 epoch 中写入相同的计数值，快照中计数值不一致时按撕裂计
+            "EpochGroup", 1, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                Payload data{};
+                fill(data, writer, counter);
+                g_group.commit(data, data);
+            },
+            [](Payload& out)
+            {
+                Payload other{};
+                const uint32_t epoch = g_group.snapshot(out, other);
+                if (epoch != 0 && (out.counter != other.counter || is_torn(other)))
+                {
+                    out.check[0] ^= 1;
+                }
+                return epoch;
+            },
+        },
+        {
+            // 每次提交后在组外向第一个成员发布 0 ~ 4 次，样本被覆盖时快照应失败而不是一直重试；
+            // 组外发布的计数值与提交不同，快照误读到它时按撕裂计
+            "EpochGroup/out", 1, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                Payload data{};
+                fill(data, writer, counter);
+                g_outside_group.commit(data, data);
+                for (uint32_t i = 0; i < counter % 5; ++i)
+                {
+                    fill(data, writer, ~counter - i);
+                    g_outside_a.write(data);
+                }
+            },
+            [](Payload& out)
+            {
+                Payload other{};
+                const uint32_t epoch = g_outside_group.snapshot(out, other);
+                if (epoch != 0 && (out.counter != other.counter || is_torn(other)))
+                {
+                    out.check[0] ^= 1;
+                }
+                return epoch;
+            },
+        },
+        {
+            // 池耗尽时本次写入直接跳过；并发发布时旧序号的块不能替换更新的块
+            "LoanedTopic", MAX_WRITER_CNT, true,
+            [](const uint32_t writer, const uint32_t counter)
+            {
+                if (Loan<Payload> loan = g_loaned.loan())
+                {
+                    fill(*loan, writer, counter);
+                    g_loaned.publish(std::move(loan));
+                }
+            },
+            [](Payload& out)
+            {
+                const Shared<Payload> val = g_loaned.acquire();
+                if (!val)
+                {
+                    return 0U;
+                }
+                out = *val;
+                return val.seq();
+            },
+        },
+    };
+
+    // 单线程检查：最近一个 epoch 的样本被组外发布覆盖后 snapshot() 返回 0，下一次提交后恢复
+    bool check_epoch_outside()
+    {
+        NBuf<uint32_t, 4> a;
+        NBuf<uint32_t, 4> b;
+        EpochGroup group(a, b);
+        uint32_t x{}, y{};
+
+        group.commit(1, 1);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            a.write(100 + i);
+        }
+        if (group.snapshot(x, y) != 0)
+        {
+            LOG_ERR("EpochGroup snapshot succeeded on overwritten samples");
+            return false;
+        }
+
+        if (group.commit(2, 2) != 2 || group.snapshot(x, y) != 2 || x != 2 || y != 2)
+        {
+            LOG_ERR("EpochGroup snapshot did not recover after commit");
+            return false;
+        }
+        return true;
+    }
+
+    const Target* g_target;
+    atomic_t g_running = ATOMIC_INIT(0);
+    atomic_t g_writes = ATOMIC_INIT(0);
+    atomic_t g_reads = ATOMIC_INIT(0);
+    atomic_t g_torn = ATOMIC_INIT(0);
+    atomic_t g_seq_regress = ATOMIC_INIT(0);
+
+    K_THREAD_STACK_ARRAY_DEFINE(writer_stacks, MAX_WRITER_CNT, STACK_SIZE);
+    K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, READER_CNT, STACK_SIZE);
+    k_thread writer_threads[MAX_WRITER_CNT];
+    k_thread reader_threads[READER_CNT];
+
+    void writer_entry(void* p1, void*, void*)
+    {
+        const auto writer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(p1));
+        uint32_t counter{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 256; ++burst)
+            {
+                g_target->write(writer, ++counter);
+            }
+            atomic_add(&g_writes, 256);
+            k_yield();
+        }
+    }
+
+    void reader_entry(void*, void*, void*)
+    {
+        Payload data{};
+        uint32_t last_seq{};
+        while (atomic_get(&g_running))
+        {
+            for (size_t burst = 0; burst < 256; ++burst)
+            {
+                const uint32_t seq = g_target->read(data);
+                if (seq == 0)
+                {
+                    continue;
+                }
+                if (is_torn(data))
+                {
+                    atomic_inc(&g_torn);
+                }
+                if (g_target->monotonic && static_cast<int32_t>(seq - last_seq) < 0)
+                {
+                    atomic_inc(&g_seq_regress);
+                }
+                last_seq = seq;
+            }
+            atomic_add(&g_reads, 256);
+            k_yield();
+        }
+    }
+
+    // 线程创建后暂不启动，固定到 cpu 后再运行；未开启 CPU 掩码时由调度器自由分配
+    void spawn(k_thread& thread, k_thread_stack_t* stack, const k_thread_entry_t entry, const uintptr_t arg,
+               const int cpu)
+    {
+        k_thread_create(&thread, stack, STACK_SIZE, entry, reinterpret_cast<void*>(arg), nullptr, nullptr,
+                        PRIORITY, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+        k_thread_cpu_pin(&thread, cpu);
+#else
+        ARG_UNUSED(cpu);
+#endif
+        k_thread_start(&thread);
+    }
+
+    bool run(const Target& target)
+    {
+        const unsigned int cpus = arch_num_cpus();
+        g_target = &target;
+        atomic_clear(&g_writes);
+        atomic_clear(&g_reads);
+        atomic_clear(&g_torn);
+        atomic_clear(&g_seq_regress);
+        atomic_set(&g_running, 1);
+
+        // 写者依次占用 CPU 0, 1, ...，读者从写者的下一个核心开始，保证读写跨核
+        for (size_t i = 0; i < target.writer_cnt; ++i)
+        {
+            spawn(writer_threads[i], writer_stacks[i], writer_entry, i + 1, static_cast<int>(i % cpus));
+        }
+        for (size_t i = 0; i < READER_CNT; ++i)
+        {
+            spawn(reader_threads[i], reader_stacks[i], reader_entry, i + 1, static_cast<int>((i + 1) % cpus));
+        }
+
+        k_msleep(RUN_TIME_MS);
+        atomic_clear(&g_running);
+        for (size_t i = 0; i < target.writer_cnt; ++i)
+        {
+            k_thread_join(&writer_threads[i], K_FOREVER);
+        }
+        for (auto& thread : reader_threads)
+        {
+            k_thread_join(&thread, K_FOREVER);
+        }
+
+        const auto torn = atomic_get(&g_torn);
+        const auto regress = atomic_get(&g_seq_regress);
+        LOG_INF("%-14s writes: %ld, reads: %ld, torn: %ld, seq regressions: %ld", target.name,
+                atomic_get(&g_writes), atomic_get(&g_reads), torn, regress);
+        return torn == 0 && regress == 0;
+    }
+}
+
+int main()
+{
+    LOG_INF("SMP stress: %u CPUs, %u readers, %d ms per buffer", arch_num_cpus(),
+            static_cast<unsigned>(READER_CNT), RUN_TIME_MS);
+
+    bool pass = check_epoch_outside();
+    for (const auto& target : targets)
+    {
+        pass &= run(target);
+    }
+
+    if (!pass)
+    {
+        LOG_ERR("FAIL");
+        return -1;
+    }
+    LOG_INF("PASS");
+    return 0;
+}
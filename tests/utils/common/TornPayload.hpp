@@ -0,0 +1,51 @@
+#ifndef OF_TESTS_UTILS_TORNPAYLOAD_HPP
+#define OF_TESTS_UTILS_TORNPAYLOAD_HPP
+
+// 缓冲区压力测试共用的样本：每个字都由 (writer, counter) 推导，读到混合两次写入的数据即可被发现。
+// 测试的 CMakeLists.txt 中以 target_include_directories(app PRIVATE ../common) 引入
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace OF::test
+{
+    template <size_t CheckN>
+    struct TornPayload
+    {
+        uint32_t writer;
+        uint32_t counter;
+        uint32_t check[CheckN];
+    };
+
+    constexpr uint32_t check_word(const uint32_t writer, const uint32_t counter, const size_t i)
+    {
+        return (writer * 0x9E3779B9u) ^ (counter * 0x85EBCA6Bu) ^ static_cast<uint32_t>(i);
+    }
+
+    template <size_t CheckN>
+    void fill(TornPayload<CheckN>& data, const uint32_t writer, const uint32_t counter)
+    {
+        data.writer = writer;
+        data.counter = counter;
+        for (size_t i = 0; i < CheckN; ++i)
+        {
+            data.check[i] = check_word(writer, counter, i);
+        }
+    }
+
+    template <size_t CheckN>
+    bool is_torn(const TornPayload<CheckN>& data)
+    {
+        for (size_t i = 0; i < CheckN; ++i)
+        {
+            if (data.check[i] != check_word(data.writer, data.counter, i))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+#endif //OF_TESTS_UTILS_TORNPAYLOAD_HPP